@@ -0,0 +1,20 @@
+/* avr/interrupt.h - interrupt control for the host port */
+
+#ifndef	_HOST_AVR_INTERRUPT_H
+#define	_HOST_AVR_INTERRUPT_H
+
+#include <avr/io.h>
+
+extern	void	hostsei(void);
+
+/* A handler is a plain function; the host clock calls it by name	*/
+
+#define	ISR(vector, ...)	void vector(void)
+#define	ISR_NAKED
+#define	ISR_NOBLOCK
+#define	reti()
+
+#define	sei()	hostsei()
+#define	cli()	(hostsreg &= ~0x80)
+
+#endif
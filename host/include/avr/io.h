@@ -0,0 +1,81 @@
+/* avr/io.h - AVR registers as seen by the host port */
+
+/* Registers the kernel reads or writes are bytes of hostio[], which	*/
+/*   nothing else looks at, except for the few the host platform keeps	*/
+/*   alive: SREG is the simulated status register (its I bit gates the	*/
+/*   clock interrupt) and TCNT2/TIFR2 come from the TIMER2 model in	*/
+/*   system/clkinit.c, which also follows what the kernel writes to	*/
+/*   TCNT2, TCCR2B and OCR2A (the tickless idle of clkidle.c).  UDR0	*/
+/*   and the UDRIE0 bit of UCSR0B drive the UART transmitter of		*/
+/*   system/platinit.c, which sends to standard output.			*/
+
+#ifndef	_HOST_AVR_IO_H
+#define	_HOST_AVR_IO_H
+
+#include <stdint.h>
+
+extern	volatile uint8_t	hostio[256];	/* Unused I/O space	*/
+extern	volatile uint8_t	hostsreg;	/* Simulated SREG	*/
+extern	volatile uint8_t	*hosttcnt2(void);
+extern	volatile uint8_t	*hosttifr2(void);
+extern	volatile uint8_t	*hostudr0(void);
+
+#define	_SFR_MEM8(x)	(hostio[(x) & 0xff])
+#define	_SFR_IO8(x)	(hostio[((x) + 0x20) & 0xff])
+#define	_SFR_MEM16(x)	(*(volatile uint16_t *)&hostio[(x) & 0xfe])
+#define	_BV(b)		(1 << (b))
+
+#define	SREG	hostsreg
+#define	SP	_SFR_MEM16(0x5d)
+#define	SPL	_SFR_MEM8(0x5d)
+#define	SPH	_SFR_MEM8(0x5e)
+
+#define	TCNT2	(*hosttcnt2())
+#define	TIFR2	(*hosttifr2())
+#define	TCCR2A	_SFR_MEM8(0xb0)
+#define	TCCR2B	_SFR_MEM8(0xb1)
+#define	OCR2A	_SFR_MEM8(0xb3)
+#define	OCR2B	_SFR_MEM8(0xb4)
+#define	TIMSK2	_SFR_MEM8(0x70)
+#define	OCF2A	1
+#define	OCIE2A	1
+
+#define	TCNT1	_SFR_MEM16(0x84)
+#define	TCCR1A	_SFR_MEM8(0x80)
+#define	TCCR1B	_SFR_MEM8(0x81)
+#define	CS10	0
+
+#define	UDR0	(*hostudr0())
+#define	UCSR0A	_SFR_MEM8(0xc0)
+#define	UCSR0B	_SFR_MEM8(0xc1)
+#define	UCSR0C	_SFR_MEM8(0xc2)
+#define	UBRR0L	_SFR_MEM8(0xc4)
+#define	UBRR0H	_SFR_MEM8(0xc5)
+#define	UBRR0	_SFR_MEM16(0xc4)
+#define	RXC0	7
+#define	TXC0	6
+#define	UDRE0	5
+#define	FE0	4
+#define	DOR0	3
+#define	UPE0	2
+#define	U2X0	1
+#define	RXCIE0	7
+#define	TXCIE0	6
+#define	UDRIE0	5
+#define	RXEN0	4
+#define	TXEN0	3
+#define	UCSZ01	2
+#define	UCSZ00	1
+
+#define	SMCR	_SFR_IO8(0x33)
+#define	SE	0
+
+#define	DDRB	_SFR_IO8(0x04)
+#define	PORTB	_SFR_IO8(0x05)
+#define	PINB	_SFR_IO8(0x03)
+#define	DDRD	_SFR_IO8(0x0a)
+#define	PORTD	_SFR_IO8(0x0b)
+#define	PIND	_SFR_IO8(0x09)
+#define	PB5	5
+
+#endif
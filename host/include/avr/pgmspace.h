@@ -0,0 +1,15 @@
+/* avr/pgmspace.h - the host has a single address space */
+
+#ifndef	_HOST_AVR_PGMSPACE_H
+#define	_HOST_AVR_PGMSPACE_H
+
+#define	PROGMEM
+#define	PSTR(s)			(s)
+#define	pgm_read_byte(a)	(*(const unsigned char *)(a))
+#define	pgm_read_word(a)	(*(const unsigned short *)(a))
+#define	pgm_read_ptr(a)		(*(void * const *)(a))
+#define	strncpy_P(d, s, n)	strncpy((d), (s), (n))
+#define	strcmp_P(a, b)		strcmp((a), (b))
+#define	memcpy_P(d, s, n)	memcpy((d), (s), (n))
+
+#endif
@@ -0,0 +1,10 @@
+/* avr/sleep.h - sleeping on the host waits for the next interrupt */
+
+extern	void	hostsleep(void);
+
+#define	SLEEP_MODE_IDLE		0
+#define	set_sleep_mode(m)
+#define	sleep_enable()
+#define	sleep_disable()
+#define	sleep_cpu()	hostsleep()
+#define	sleep_mode()	hostsleep()
@@ -0,0 +1,6 @@
+/* avr/wdt.h - there is no watchdog on the host */
+
+#define	WDTO_15MS	0
+#define	wdt_enable(t)
+#define	wdt_disable()
+#define	wdt_reset()
@@ -0,0 +1,26 @@
+/* hostos.h - interface between the host platform layer and Linux */
+
+/* The kernel headers shadow the C library's (stdio.h, string.h, ...),	*/
+/*   so everything that needs Linux headers lives in hostos.c and is	*/
+/*   reached only through these functions.				*/
+
+extern	void	hostnewctx(int, void *, unsigned long, void (*)(void));
+extern	void	hostswitch(int, int);
+extern	void	hoststarttick(void (*)(void));
+extern	void	hostsettick(unsigned long long);
+extern	void	hostputc(char);
+extern	unsigned long long hostmicros(void);
+extern	void	hostexit(int);
+
+/* Xinu side of the host platform (host/system) */
+
+#define	SREG_I		0x80		/* I bit of the simulated SREG	*/
+
+extern	void	hostirq(void);
+extern	int	hostt2due(void);
+extern	void	TIMER2_COMPA_vect(void);
+extern	void	USART_UDRE_vect(void);
+extern	void	hostuart(void);
+extern	volatile unsigned char hostpending; /* Tick held while I was 0	*/
+extern	volatile unsigned int hostnirq;	/* Interrupt handlers run	*/
+extern	void	(*hostextisr)(void);	/* Extra ISR run on each tick	*/
@@ -0,0 +1,20 @@
+/* klog.h - klog (host) */
+
+/* A record holds the low half of its format's address, which on the	*/
+/*   AVR is the whole flash address.  Here the formats go to their own	*/
+/*   section, .klfmt, which the Makefile links 16 bytes past a 64 KB	*/
+/*   boundary: the low half then tells the formats apart and is never	*/
+/*   0, the fmt of a lost record, and tools/klogdec looks them up in	*/
+/*   the host program.  The rest is the kernel's header.		*/
+
+#include_next <klog.h>
+
+#if KLOG
+
+#undef	klog
+#define	klog(fmt, ...)							\
+	klogf(({ static const char klfmt[]				\
+		 __attribute__((section(".klfmt"))) = fmt; klfmt; }),	\
+	      ##__VA_ARGS__)
+
+#endif
@@ -0,0 +1 @@
+/* util/atomic.h - nothing in the kernel needs it on the host */
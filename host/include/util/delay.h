@@ -0,0 +1,4 @@
+/* util/delay.h - busy-wait delays are no-ops on the host */
+
+#define	_delay_ms(ms)
+#define	_delay_us(us)
@@ -0,0 +1,25 @@
+/* xtask.h - XINU_TASK (host) */
+
+/* The kernel's XINU_TASK links each task into the table from a naked	*/
+/*   function in .init7, which only the avr-libc startup code runs.	*/
+/*   Here the same fragment is an ordinary function the C library runs	*/
+/*   as a constructor, also before nulluser, so the daemons and tasks	*/
+/*   exist on the host as well.  The rest is the kernel's header.	*/
+
+#include_next <xtask.h>
+
+#undef	XINU_TASK
+#define	XINU_TASK(name, fn, stack, prio)				\
+	static	byte	name##_xstk[((stack) + 7) & ~7];		\
+	struct	xtask	name##_xtask = {				\
+		NULL, (int (*)())(fn), name##_xstk,			\
+		sizeof(name##_xstk), (prio), #name, SYSERR		\
+	};								\
+	static	void	name##_xlink(void)				\
+		__attribute__((constructor));				\
+	static	void	name##_xlink(void)				\
+	{								\
+		*xtasktail = &name##_xtask;				\
+		xtasktail = &name##_xtask.xnext;			\
+	}								\
+	extern	struct	xtask	name##_xtask
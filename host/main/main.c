@@ -0,0 +1,159 @@
+/* main.c - main, pinger, ponger, npinger, nponger (host benchmark) */
+
+/* Runs on the host build of the kernel (see ../Makefile): measures the	*/
+/*   cost of the semaphore handoff that every driver in main/ relies	*/
+/*   on, of the same handoff with notify/notifywait, of		*/
+/*   getmem/freemem, and how far sleepms() overshoots, then		*/
+/*   ends the program.  The numbers compare kernel changes with each	*/
+/*   other; they are not AVR cycle counts.				*/
+
+#include <xinu.h>
+#include <hostos.h>
+
+#define	NROUNDS		200000	/* Ping-pong round trips		*/
+#define	NALLOCS		200000	/* getmem/freemem pairs			*/
+#define	NSLEEPS		20	/* sleepms(SLEEPMS) calls timed		*/
+#define	SLEEPMS		10
+
+sid32	semping, sempong;	/* Handoff between the two processes	*/
+sid32	semdone;		/* Signalled when ponger finishes	*/
+pid32	npingpid, npongpid;	/* Notification ping-pong processes	*/
+
+#define	NOTEPING	0x01	/* Notification bits of the handoff	*/
+#define	NOTEPONG	0x02
+
+/*------------------------------------------------------------------------
+ *  pinger  -  Hand the CPU to ponger and wait for it to hand it back
+ *------------------------------------------------------------------------
+ */
+process	pinger(void)
+{
+	int32	i;
+
+	for (i = 0; i < NROUNDS; i++) {
+		signal(sempong);
+		wait(semping);
+	}
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  ponger  -  Answer every ping
+ *------------------------------------------------------------------------
+ */
+process	ponger(void)
+{
+	int32	i;
+
+	for (i = 0; i < NROUNDS; i++) {
+		wait(sempong);
+		signal(semping);
+	}
+	signal(semdone);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  npinger  -  pinger with notifications in place of semaphores
+ *------------------------------------------------------------------------
+ */
+process	npinger(void)
+{
+	int32	i;
+
+	for (i = 0; i < NROUNDS; i++) {
+		notify(npongpid, NOTEPONG);
+		notifywait(NOTEPING, NOTIFYFOREVER);
+	}
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  nponger  -  ponger with notifications in place of semaphores
+ *------------------------------------------------------------------------
+ */
+process	nponger(void)
+{
+	int32	i;
+
+	for (i = 0; i < NROUNDS; i++) {
+		notifywait(NOTEPONG, NOTIFYFOREVER);
+		notify(npingpid, NOTEPING);
+	}
+	signal(semdone);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  main  -  Run each benchmark and print one line per result
+ *------------------------------------------------------------------------
+ */
+process	main(void)
+{
+	unsigned long long t0, t1;	/* hostmicros() around a test	*/
+	unsigned long long worst;	/* Largest sleep overshoot (us)	*/
+	char	*blk;
+	int32	i;
+
+	kprintf("xinu host benchmark\n");
+
+	/* Semaphore ping-pong: two switches per round trip */
+
+	semping = semcreate(0);
+	sempong = semcreate(0);
+	semdone = semcreate(0);
+	t0 = hostmicros();
+	resume(create(ponger, 256, INITPRIO + 1, "ponger", 0));
+	resume(create(pinger, 256, INITPRIO + 1, "pinger", 0));
+	wait(semdone);
+	t1 = hostmicros();
+	kprintf("pingpong: %d round trips in %llu us, %llu ns/switch\n",
+		NROUNDS, t1 - t0, (t1 - t0) * 1000 / (2ULL * NROUNDS));
+
+	/* The same with notifications */
+
+	npongpid = create(nponger, 256, INITPRIO + 1, "nponger", 0);
+	npingpid = create(npinger, 256, INITPRIO + 1, "npinger", 0);
+	t0 = hostmicros();
+	resume(npongpid);
+	resume(npingpid);
+	wait(semdone);
+	t1 = hostmicros();
+	kprintf("notify: %d round trips in %llu us, %llu ns/switch\n",
+		NROUNDS, t1 - t0, (t1 - t0) * 1000 / (2ULL * NROUNDS));
+
+	/* Heap allocation */
+
+	t0 = hostmicros();
+	for (i = 0; i < NALLOCS; i++) {
+		blk = getmem(32);
+		if (blk == (char *)SYSERR) {
+			panic("getmem");
+		}
+		freemem(blk, 32);
+	}
+	t1 = hostmicros();
+	kprintf("getmem: %d alloc/free pairs, %llu ns/pair\n",
+		NALLOCS, (t1 - t0) * 1000 / NALLOCS);
+
+	/* Sleep accuracy against the host clock */
+
+	worst = 0;
+	t0 = hostmicros();
+	for (i = 0; i < NSLEEPS; i++) {
+		t1 = hostmicros();
+		sleepms(SLEEPMS);
+		t1 = hostmicros() - t1;
+		if (t1 > worst) {
+			worst = t1;
+		}
+	}
+	t1 = hostmicros();
+	kprintf("sleepms(%d): mean %llu us, worst %llu us\n", SLEEPMS,
+		(t1 - t0) / NSLEEPS, worst);
+	kprintf("clock: %d ticks, getmicros %d us\n", (int)getticks(),
+		(int)getmicros());
+
+	hostexit(0);
+	return OK;
+}
@@ -0,0 +1,187 @@
+/* clkinit.c - clkinit, hostirq, hostt2due, hosttcnt2, hosttifr2 (host) */
+
+#include <xinu.h>
+#include <hostos.h>
+
+#include <avr/io.h>
+
+uint32	clktime;		/* Seconds since boot			*/
+uint32	clkticks;		/* Milliseconds since boot		*/
+uint32	count1000;	/* ms since last clock tick             */
+qid16	sleepq;			/* Queue of sleeping processes		*/
+uint32	preempt;		/* Preemption counter			*/
+
+volatile uint8	hostpending;	/* A tick arrived while I was clear	*/
+volatile uint32	hostnirq;	/* Interrupt handlers run so far	*/
+void	(*hostextisr)(void);	/* Handler a test runs on every tick	*/
+local	volatile uint8	hostreg;    /* Value read from TIFR2		*/
+
+/*
+ * TIMER2 model.  The counter is not stored: it is the host time since
+ * t2zero divided by the time per count, so it runs whether or not
+ * anybody reads it.  At the kernel's 1 ms tick (prescaler 128) a period
+ * is 125 counts of 8 us; with the idle prescaler of clkidle.c (1024) it
+ * is OCR2A + 1 counts of 64 us.  A compare match restarts the period
+ * at the exact time it was due, however late the SIGALRM for it comes,
+ * and sets t2flag (OCF2A) until the handler runs.  A write to TCNT2
+ * goes to t2reg and is seen when the model next runs, which is before
+ * interrupts are enabled again, as every kernel write is made with
+ * them disabled; it took effect when the kernel last reached TCNT2,
+ * just before storing into it.
+ */
+
+#define	CLKUSPERCNT	8	/* us per TIMER2 count, as on the AVR	*/
+#define	CLKOCR_TICK	125	/* TIMER2 counts per 1 ms tick		*/
+#define	CLKCS_TICK	0b00000101	/* prescaler 128 (clkinit.c)	*/
+#define	CLKCS_IDLE	0b00000111	/* prescaler 1024 (clkidle.c)	*/
+
+local	unsigned long long t2zero; /* hostmicros() when TCNT2 was 0	*/
+local	uint16	t2us;		/* us per count				*/
+local	uint8	t2cs;		/* Clock select the model runs with	*/
+local	uint8	t2ocr;		/* OCR2A the model runs with		*/
+local	uint8	t2last;		/* Count last handed out in t2reg	*/
+local	volatile uint8	t2reg;	/* TCNT2 as the kernel reads and writes	*/
+local	unsigned long long t2access; /* hostmicros() at the last access	*/
+local	volatile uint8	t2flag;	/* OCF2A: a match not yet handled	*/
+
+/*------------------------------------------------------------------------
+ * t2period  -  Length of the current TIMER2 period in us
+ *------------------------------------------------------------------------
+ */
+local	uint32	t2period(void)
+{
+	if (t2cs == CLKCS_IDLE) {
+		return ((uint32)t2ocr + 1) * t2us;
+	}
+	return CLKOCR_TICK * t2us;
+}
+
+/*------------------------------------------------------------------------
+ * t2update  -  Bring the model up to date: take the kernel's writes,
+ *		  restart the period on a match and refresh t2reg
+ *------------------------------------------------------------------------
+ */
+local	void	t2update(void)
+{
+	unsigned long long now;		/* Host time			*/
+	uint32	counts;			/* Counts into the period	*/
+	uint8	cs;			/* Clock select now in TCCR2B	*/
+
+	now = hostmicros();
+	cs = TCCR2B & 0x07;
+	if (t2reg != t2last) {			/* TCNT2 was written	*/
+		t2cs = cs;
+		t2us = (cs == CLKCS_IDLE) ? 8 * CLKUSPERCNT : CLKUSPERCNT;
+		t2zero = t2access - (uint32)t2reg * t2us;
+	} else if (cs != t2cs) {		/* Prescaler changed	*/
+		counts = (now - t2zero) / t2us;
+		t2cs = cs;
+		t2us = (cs == CLKCS_IDLE) ? 8 * CLKUSPERCNT : CLKUSPERCNT;
+		t2zero = now - counts * t2us;
+	}
+	t2ocr = OCR2A;
+
+	if (now - t2zero >= t2period()) {
+		t2zero += t2period();
+		t2flag = 1;
+	}
+	counts = (now - t2zero) / t2us;
+	if (counts >= t2period() / t2us) {	/* Next match overdue	*/
+		counts = t2period() / t2us - 1;
+	}
+	t2last = t2reg = counts;
+	t2access = now;
+}
+
+/*------------------------------------------------------------------------
+ * clkinit  -  Initialize the clock and sleep queue at startup; the
+ *	       compare match is a SIGALRM from a one-shot host timer
+ *------------------------------------------------------------------------
+ */
+void clkinit(void)
+{
+	sleepq = newqueue();	/* Allocate a queue to hold the delta	*/
+				/*   list of sleeping processes		*/
+	preempt = QUANTUM;	/* Set the preemption time		*/
+	clktime = 0;		/* Start counting seconds		*/
+	clkticks = 0;		/* Start counting milliseconds		*/
+	count1000 = 0;
+
+	TCCR2B = CLKCS_TICK;	/* As the AVR clkinit programs TIMER2	*/
+	OCR2A = CLKOCR_TICK;
+	t2us = CLKUSPERCNT;
+	t2cs = CLKCS_TICK;
+	t2ocr = CLKOCR_TICK;
+	t2zero = hostmicros();
+	hoststarttick(hostirq);
+	hostsettick(t2zero + t2period());
+}
+
+/*------------------------------------------------------------------------
+ * hostirq  -  Run the clock handler if the I bit allows it and a match
+ *	       is due, else leave the tick pending the way the AVR latches
+ *	       OCF2A; hostextisr, if set, stands for a second interrupt
+ *	       source and runs next, then the UART (see hostuart).
+ *	       Called on SIGALRM and whenever the I bit is set with
+ *	       something pending (see hostt2due)
+ *------------------------------------------------------------------------
+ */
+void	hostirq(void)
+{
+	if (!(hostsreg & SREG_I)) {
+		hostpending = 1;
+		return;
+	}
+	do {
+		hostpending = 0;
+		hostsreg &= ~SREG_I;	/* The CPU clears I on entry	*/
+		t2update();
+		hostsettick(t2zero + t2period());
+		if (t2flag) {
+			t2flag = 0;
+			hostnirq++;
+			TIMER2_COMPA_vect();
+			if (hostextisr != NULL) {
+				hostextisr();
+			}
+			hostuart();
+		}
+		hostsreg |= SREG_I;	/* ... and reti sets it again	*/
+
+		/* A SIGALRM taken meanwhile found I clear; the timer	*/
+		/*   is one-shot, so nothing else would look at it	*/
+
+	} while (hostpending);
+}
+
+/*------------------------------------------------------------------------
+ * hostt2due  -  Nonzero if the model must run when I is set: a match
+ *		   is waiting or the kernel reprogrammed TIMER2
+ *------------------------------------------------------------------------
+ */
+int	hostt2due(void)
+{
+	return t2flag || t2reg != t2last || (TCCR2B & 0x07) != t2cs
+		|| (t2cs == CLKCS_IDLE && OCR2A != t2ocr);
+}
+
+/*------------------------------------------------------------------------
+ * hosttcnt2  -  TCNT2 as the kernel reads or writes it
+ *------------------------------------------------------------------------
+ */
+volatile uint8	*hosttcnt2(void)
+{
+	t2update();
+	return &t2reg;
+}
+
+/*------------------------------------------------------------------------
+ * hosttifr2  -  TIFR2 as the kernel reads it: OCF2A while a tick waits
+ *------------------------------------------------------------------------
+ */
+volatile uint8	*hosttifr2(void)
+{
+	t2update();
+	hostreg = t2flag ? (1 << OCF2A) : 0;
+	return &hostreg;
+}
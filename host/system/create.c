@@ -0,0 +1,216 @@
+/* create.c - create, createat, procinit, newpid, procstart (host) */
+
+#include <stdarg.h>
+#include <xinu.h>
+#include <hostos.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+local	pid32	newpid(void);
+local	pid32	procinit(int (*)(), int, int, char *, int, int32 *);
+local	void	procstart(void);
+
+/* On the host every stack also carries the frames of the C library and	*/
+/*   of the SIGALRM handler, so HOSTSTK bytes are added to the size	*/
+/*   the caller asked for.  Static XINU_TASK stacks are too small for	*/
+/*   that and are left unused: createat takes its stack from the heap.	*/
+
+#define	HOSTSTK		16384	/* Extra stack for host frames		*/
+
+local	int	(*procentry[NPROC])();	/* Procedure each process runs	*/
+local	int	procnargs[NPROC];	/* Number of args it is passed	*/
+
+/*------------------------------------------------------------------------
+ *  create  -  create a process to start running a procedure
+ *------------------------------------------------------------------------
+ */
+pid32	create(
+	  int		(*procaddr)(),	/* procedure address		*/
+	  int		ssize,		/* stack size in bytes		*/
+	  int		priority,	/* process priority > 0		*/
+	  char		*name,		/* name (for debugging)		*/
+	  int		nargs,		/* number of args that follow	*/
+	  ...
+	)
+{
+	intmask		mask;		/* interrupt mask		*/
+	pid32		pid;		/* stores new process id	*/
+	int32		args[MAXARG];	/* the args themselves		*/
+	va_list		ap;
+	int		i;
+
+	mask = disable();
+	if (ssize < MINSTK)
+		ssize = MINSTK;
+	if (nargs < 0 || nargs > MAXARG) {
+		restore(mask);
+		return SYSERR;
+	}
+	va_start(ap, nargs);
+	for (i = 0; i < nargs; i++) {
+		args[i] = va_arg(ap, int);
+	}
+	va_end(ap);
+
+	pid = procinit(procaddr, ssize, priority, name, nargs, args);
+	if (pid == SYSERR) {
+		avr_kprintf(m10);
+	}
+	restore(mask);
+	return pid;
+}
+
+/*------------------------------------------------------------------------
+ *  createat  -  create a process for a XINU_TASK (the stack provided by
+ *		   the caller is not used on the host)
+ *------------------------------------------------------------------------
+ */
+pid32	createat(
+	  int		(*procaddr)(),	/* procedure address		*/
+	  byte		*stk,		/* lowest address of the stack	*/
+	  int		ssize,		/* stack size in bytes		*/
+	  int		priority,	/* process priority > 0		*/
+	  char		*name		/* name (for debugging)		*/
+	)
+{
+	intmask		mask;		/* interrupt mask		*/
+	pid32		pid;		/* stores new process id	*/
+
+	mask = disable();
+	if (ssize < MINSTK || (ssize & 7) != 0) {
+		restore(mask);
+		return SYSERR;
+	}
+	pid = procinit(procaddr, ssize, priority, name, 0, NULL);
+	restore(mask);
+	return pid;
+}
+
+/*------------------------------------------------------------------------
+ *  procinit  -  allocate a stack and table entry for a new process and
+ *		   prepare its host context
+ *------------------------------------------------------------------------
+ */
+local	pid32	procinit(
+	  int		(*procaddr)(),	/* procedure address		*/
+	  int		ssize,		/* stack size in bytes		*/
+	  int		priority,	/* process priority > 0		*/
+	  char		*name,		/* name (for debugging)		*/
+	  int		nargs,		/* number of args		*/
+	  int32		*a		/* the args themselves		*/
+	)
+{
+	struct	procent	*prptr;		/* pointer to proc. table entry */
+	pid32		pid;		/* new process id		*/
+	char		*saddr;		/* top of the stack		*/
+	byte		*paint;		/* stack painting pointer	*/
+	int		i;
+
+	ssize += HOSTSTK;
+	if (priority < 1 || isbadprio(priority) ||
+	    (saddr = getstk(ssize)) == (char *)SYSERR) {
+		return SYSERR;
+	}
+	if ((pid = newpid()) == SYSERR) {
+		freestk(saddr, ssize);
+		return SYSERR;
+	}
+
+	prcount++;
+	prptr = &proctab[pid];
+
+	/* initialize process table entry for new process */
+	prptr->prstate = PR_SUSP;	/* initial state is suspended	*/
+	prptr->prprio = priority;
+#if NMUTEX > 0
+	prptr->prbprio = priority;
+	prptr->prmutex = EMPTY;
+#endif
+	prptr->prstkbase = (unsigned char *)saddr;
+	prptr->prstklen = ssize;
+#if KCOMPACT
+	prptr->prname = name;		/* Caller's string is kept	*/
+#else
+	prptr->prname[PNMLEN-1] = NULLCH;
+	for (i=0 ; i<PNMLEN-1 && (prptr->prname[i]=name[i])!=NULLCH; i++)
+		;
+#endif
+	prptr->prsem = -1;
+	prptr->prparent = (pid32)getpid();
+	prptr->prhasmsg = FALSE;
+	prptr->prnotify = 0;
+	prptr->prnmask = 0;
+	prptr->proverrun = 0;
+#if CPUACCT
+	prptr->prcpu = 0;
+	prptr->prnswitch = 0;
+#endif
+
+	/* Paint the whole stack for stkusage(); the null process keeps	*/
+	/*   running on the host's own stack and never uses this one	*/
+
+	for (paint = stkbottom(prptr); paint <= (byte *)saddr; paint++)
+		*paint = STKPAINT;
+
+	/* Keep what procstart needs to call the procedure */
+
+	for (i = 0; i < PNREGS; i++)
+		prptr->pregs[i] = INITREG;
+	prptr->pregs[SSREG] = INITPS;
+#if !KCOMPACT
+	prptr->pargs = nargs;
+	prptr->paddr = (int *)procaddr;
+#endif
+	procentry[pid] = procaddr;
+	procnargs[pid] = nargs;
+	for (i = 0; i < nargs; i++) {
+		prptr->parg[i] = (void *)a[i];
+	}
+	prptr->parg[nargs] = 0;
+
+	if (procaddr != NULL) {
+		hostnewctx(pid, stkbottom(prptr),
+			(byte *)saddr - stkbottom(prptr), procstart);
+	}
+	return pid;
+}
+
+/*------------------------------------------------------------------------
+ *  procstart  -  first code run by a new process: call the procedure the
+ *		    way the AVR create arranges it, then userret
+ *------------------------------------------------------------------------
+ */
+local	void	procstart(void)
+{
+	struct	procent	*prptr;		/* pointer to proc. table entry */
+
+	prptr = &proctab[currpid];
+	hostsreg = prptr->pregs[SSREG];	/* as ctxsw would restore it	*/
+	hostsei();			/* deliver a tick held meanwhile*/
+	procentry[currpid](procnargs[currpid], &prptr->parg[0]);
+	INITRET();
+}
+
+/*------------------------------------------------------------------------
+ *  newpid  -  Obtain a new (free) process ID
+ *------------------------------------------------------------------------
+ */
+local	pid32	newpid(void)
+{
+	uint32	i;			/* iterate through all processes*/
+	static	pid32 nextpid = 0;	/* position in table to try or	*/
+					/*  one beyond end of table	*/
+
+	/* check all NPROC slots */
+
+	for (i = 0; i < NPROC; i++) {
+		nextpid %= NPROC;	/* wrap around to beginning */
+		if (proctab[nextpid].prstate == PR_FREE) {
+			return nextpid++;
+		} else {
+			nextpid++;
+		}
+	}
+	return (pid32) SYSERR;
+}
@@ -0,0 +1,36 @@
+/* ctxsw.c - ctxsw (host) */
+
+#include <xinu.h>
+#include <hostos.h>
+
+#include <avr/io.h>
+
+/*------------------------------------------------------------------------
+ *  ctxsw  -  Switch from the process whose register area is old to the
+ *	      one whose register area is new.  The host context lives in
+ *	      hostos.c; only the simulated SREG is kept in pregs, as the
+ *	      AVR ctxsw does, so each process gets its own interrupt state
+ *------------------------------------------------------------------------
+ */
+void	ctxsw(
+	  void		*old,		/* pregs of the current process	*/
+	  void		*new		/* pregs of the process to run	*/
+	)
+{
+	unsigned char	*regs = old;	/* Register area being saved	*/
+	pid32	from, to;		/* Processes owning old and new	*/
+
+	from = (struct procent *)((char *)old -
+		__builtin_offsetof(struct procent, pregs)) - proctab;
+	to = (struct procent *)((char *)new -
+		__builtin_offsetof(struct procent, pregs)) - proctab;
+
+	regs[SSREG] = hostsreg;
+	if (from != to) {
+		hostswitch(from, to);
+	}
+
+	/* Back in the process that called ctxsw */
+
+	hostsreg = regs[SSREG];
+}
@@ -0,0 +1,169 @@
+/* hostos.c - hostnewctx, hostswitch, hoststarttick, hostsettick,
+ *	      hostputc, hostmicros, hostexit, main
+ *
+ * Linux side of the host platform.  Process contexts are ucontexts
+ * switched with swapcontext(), and the clock interrupt is SIGALRM from
+ * a one-shot itimer that the timer model (clkinit.c) sets for each
+ * compare match.  The handler may switch processes (resched() runs
+ * inside clkhandler) exactly as the AVR timer ISR does; the interrupted
+ * process finishes the handler when it is switched back in.
+ *
+ * Only names the kernel does not define may be used here: the kernel
+ * has its own kill, signal, wait, sleep, read, write, putc, exit, ...
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/prctl.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "hostos.h"
+
+extern	void	nulluser(void);	/* The kernel, in initialize.c	*/
+
+#define	HOSTNPROC	64		/* Upper bound on NPROC		*/
+
+static	ucontext_t	hostctx[HOSTNPROC]; /* Saved context per process	*/
+static	void	(*hosttick)(void);	/* Clock interrupt handler	*/
+
+/*------------------------------------------------------------------------
+ *  hostnewctx  -  Prepare a context that starts entry() on a stack
+ *------------------------------------------------------------------------
+ */
+void	hostnewctx(
+	  int		pid,		/* Process the context is for	*/
+	  void		*stk,		/* Lowest address of the stack	*/
+	  unsigned long	len,		/* Stack length in bytes	*/
+	  void		(*entry)(void)	/* Function to start		*/
+	)
+{
+	if (pid < 0 || pid >= HOSTNPROC || getcontext(&hostctx[pid]) < 0) {
+		fprintf(stderr, "hostnewctx: bad process %d\n", pid);
+		_exit(2);
+	}
+	hostctx[pid].uc_stack.ss_sp = stk;
+	hostctx[pid].uc_stack.ss_size = len;
+	hostctx[pid].uc_link = NULL;
+	sigemptyset(&hostctx[pid].uc_sigmask);
+	makecontext(&hostctx[pid], entry, 0);
+}
+
+/*------------------------------------------------------------------------
+ *  hostswitch  -  Save the context of process from and resume process to
+ *------------------------------------------------------------------------
+ */
+void	hostswitch(
+	  int		from,		/* Process giving up the CPU	*/
+	  int		to		/* Process to resume		*/
+	)
+{
+	swapcontext(&hostctx[from], &hostctx[to]);
+}
+
+/*------------------------------------------------------------------------
+ *  hostalarm  -  SIGALRM handler: one clock interrupt
+ *------------------------------------------------------------------------
+ */
+static	void	hostalarm(
+	  int		sig		/* Signal number (unused)	*/
+	)
+{
+	(void)sig;
+	hosttick();
+}
+
+/*------------------------------------------------------------------------
+ *  hoststarttick  -  Make tick() the SIGALRM handler; the timer slack
+ *		      goes down to 1 us so that a match is not taken up
+ *		      to 50 us late, which the kernel would see in TCNT2
+ *------------------------------------------------------------------------
+ */
+void	hoststarttick(
+	  void		(*tick)(void)	/* Clock interrupt handler	*/
+	)
+{
+	struct	sigaction	sa;
+
+	hosttick = tick;
+	sa.sa_handler = hostalarm;
+	sigemptyset(&sa.sa_mask);
+	sa.sa_flags = SA_RESTART;
+	sigaction(SIGALRM, &sa, NULL);
+	prctl(PR_SET_TIMERSLACK, 1000UL, 0, 0, 0);
+}
+
+/*------------------------------------------------------------------------
+ *  hostsettick  -  Deliver the next SIGALRM at host time when (us, as
+ *		    from hostmicros), or at once if that has passed
+ *------------------------------------------------------------------------
+ */
+void	hostsettick(
+	  unsigned long long when	/* Time of the next interrupt	*/
+	)
+{
+	struct	itimerval	it;
+	unsigned long long now;		/* Current host time		*/
+	unsigned long long usec;	/* Time left until when		*/
+
+	now = hostmicros();
+	usec = (when > now) ? when - now : 1;
+	it.it_interval.tv_sec = 0;
+	it.it_interval.tv_usec = 0;
+	it.it_value.tv_sec = usec / 1000000;
+	it.it_value.tv_usec = usec % 1000000;
+	setitimer(ITIMER_REAL, &it, NULL);
+}
+
+/*------------------------------------------------------------------------
+ *  hostputc  -  Write a character to standard output (the console)
+ *------------------------------------------------------------------------
+ */
+void	hostputc(
+	  char		c		/* Character to write		*/
+	)
+{
+	fwrite(&c, 1, 1, stdout);
+	if (c == '\n') {
+		fflush(stdout);
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  hostmicros  -  Return a monotonic time in microseconds
+ *------------------------------------------------------------------------
+ */
+unsigned long long hostmicros(void)
+{
+	struct	timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/*------------------------------------------------------------------------
+ *  hostexit  -  Flush the console and end the program
+ *------------------------------------------------------------------------
+ */
+void	hostexit(
+	  int		status		/* Exit status			*/
+	)
+{
+	fflush(stdout);
+	_exit(status);
+}
+
+/*------------------------------------------------------------------------
+ *  main  -  Program entry: the kernel starts as on reset and the calling
+ *	     thread becomes the null process
+ *------------------------------------------------------------------------
+ */
+int	main(void)
+{
+	setvbuf(stdout, NULL, _IOFBF, BUFSIZ);
+	nulluser();
+	return 0;
+}
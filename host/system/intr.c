@@ -0,0 +1,84 @@
+/* intr.c - hostsei, hostsleep, disable, restore, enable, halt, pause (host) */
+
+#include <xinu.h>
+#include <hostos.h>
+
+#include <avr/io.h>
+
+volatile uint8	hostio[256];		/* AVR I/O space nobody drives	*/
+volatile uint8	hostsreg;		/* Simulated SREG; bit 7 is I	*/
+local	uint32	hostseinirq;		/* hostnirq at the last sei()	*/
+
+/*------------------------------------------------------------------------
+ * hostsei  -  Set the I bit and take a tick that arrived meanwhile, or
+ *	      let the timer model see what the kernel wrote to TIMER2
+ *------------------------------------------------------------------------
+ */
+void	hostsei(void)
+{
+	hostseinirq = hostnirq;
+	hostsreg |= SREG_I;
+	if (hostpending || hostt2due()) {
+		hostirq();
+	}
+}
+
+/*------------------------------------------------------------------------
+ * hostsleep  -  sleep_cpu(): wait until an interrupt handler has run
+ *		 since the last sei(), as the AVR idle sleep does after
+ *		 "sei; sleep" (at once if I is clear)
+ *------------------------------------------------------------------------
+ */
+void	hostsleep(void)
+{
+	while (hostnirq == hostseinirq && (hostsreg & SREG_I)) {
+		;
+	}
+}
+
+/*------------------------------------------------------------------------
+ * disable  -  Disable interrupts and return the previous state
+ *------------------------------------------------------------------------
+ */
+intmask disable(void)
+{
+	intmask	x = hostsreg;
+
+	hostsreg &= ~SREG_I;
+	return x;
+}
+
+/*------------------------------------------------------------------------
+ * restore  -  Restore interrupts to value given by mask argument
+ *------------------------------------------------------------------------
+ */
+void restore(uint8 x)
+{
+	hostsreg = x;
+	if ((x & SREG_I) && (hostpending || hostt2due())) {
+		hostirq();
+	}
+}
+
+/*------------------------------------------------------------------------
+ * enable  -  Enable interrupts
+ *------------------------------------------------------------------------
+ */
+void enable(void)
+{
+	hostsei();
+}
+
+/*------------------------------------------------------------------------
+ * pause or halt  -  Stop: the host program ends
+ *------------------------------------------------------------------------
+ */
+void halt(void)
+{
+	hostexit(0);
+}
+
+void pause(void)
+{
+	hostexit(0);
+}
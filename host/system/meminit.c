@@ -0,0 +1,33 @@
+/* meminit.c - meminit (host) */
+
+#include <xinu.h>
+
+#define	HOSTHEAP	(1024L * 1024)	/* Bytes of simulated RAM	*/
+
+void	*minheap;	/* Start address of heap	*/
+void	*maxheap;	/* End address of heap		*/
+
+local	char	hostheap[HOSTHEAP] __attribute__((aligned(MBROUND)));
+
+/*------------------------------------------------------------------------
+ * meminit - Initialize the free memory list as one static array
+ *------------------------------------------------------------------------
+ */
+void	meminit(void)
+{
+	struct	memblk *memptr;	/* Memory block pointer	*/
+
+	/* Initialize the minheap and maxheap variables */
+
+	minheap = &hostheap[0];
+	maxheap = &hostheap[HOSTHEAP];
+
+	/* Initialize the memory list as one big block */
+
+	memlist.mnext = (struct memblk *)minheap;
+	memptr = memlist.mnext;
+
+	memptr->mnext = (struct memblk *)NULL;
+	memlist.mlength = memptr->mlength =
+		(uint32)maxheap - (uint32)minheap;
+}
@@ -0,0 +1,110 @@
+/* platinit.c - platinit, kserial_init, kserial_setbaud, kserial_getbaud,
+ *		kserial_put_char, kserial_get_char, kserial_put_str,
+ *		kserial_get_str, hostudr0, hostuart (host)
+ */
+
+#include <xinu.h>
+#include <hostos.h>
+
+#include <avr/io.h>
+
+/*------------------------------------------------------------------------
+ * platinit - platform specific initialization
+ *------------------------------------------------------------------------
+ */
+void platinit(void)
+{
+	hostsreg = 0;		/* Interrupts start disabled, as on reset */
+	kserial_init();
+}
+
+/*------------------------------------------------------------------------
+ * kserial_*  -  The kernel's polled UART is the host's standard output
+ *------------------------------------------------------------------------
+ */
+local	uint32	kserial_baud = CONSOLEBAUD;	/* Only remembered	*/
+
+void kserial_init(void)
+{
+}
+
+status kserial_setbaud(uint32 baud)
+{
+	if (baud == 0) {
+		return SYSERR;
+	}
+	kserial_baud = baud;
+	return OK;
+}
+
+uint32 kserial_getbaud(void)
+{
+	return kserial_baud;
+}
+
+void kserial_put_char(char c)
+{
+	if (c != '\r') {
+		hostputc(c);
+	}
+}
+
+char kserial_get_char(void)
+{
+	return 0;
+}
+
+void kserial_put_str(char *s)
+{
+	while (*s) {
+		kserial_put_char(*s++);
+	}
+}
+
+char *kserial_get_str(void)
+{
+	return "";
+}
+
+/*------------------------------------------------------------------------
+ * UART transmitter model.  A byte stored into UDR0 waits in udrbyte
+ * and goes to standard output at the next tick, when the data register
+ * empty handler is also run if UCSR0B enables it: one byte a ms, close
+ * to the 9600 bit/s of CONSOLEBAUD.  The byte is sent from hostuart and
+ * not right after the handler returns, as isr_exit may switch to
+ * another process first.  Reads of UDR0 (no receiver) are not expected
+ *------------------------------------------------------------------------
+ */
+local	uint8	udrbyte;	/* Last byte stored into UDR0		*/
+local	bool8	udrfull;	/* udrbyte is still to be sent		*/
+
+/*------------------------------------------------------------------------
+ * hostudr0  -  UDR0 as the kernel writes it
+ *------------------------------------------------------------------------
+ */
+volatile uint8	*hostudr0(void)
+{
+	if (udrfull) {			/* Stored twice in one tick	*/
+		hostputc(udrbyte);
+	}
+	udrfull = TRUE;
+	return &udrbyte;
+}
+
+/*------------------------------------------------------------------------
+ * hostuart  -  Called on every tick: send the byte waiting in UDR0 and
+ *		run the data register empty handler if it is enabled
+ *------------------------------------------------------------------------
+ */
+void	hostuart(void)
+{
+	if (udrfull) {
+		udrfull = FALSE;
+		hostputc(udrbyte);
+	}
+#if Ntty > 0
+	if (UCSR0B & (1 << UDRIE0)) {
+		USART_UDRE_vect();
+	}
+#endif
+}
@@ -0,0 +1,193 @@
+/* dwork.c - main, tickpost, logwork, rework, nowork, logis (host test) */
+
+/* Deferred work posted from an interrupt handler (hostextisr, run on	*/
+/*   every tick): items posted together run once each in the order	*/
+/*   they were posted, a second post of a pending item is merged, an	*/
+/*   item re-posted from its own function runs again after the others	*/
+/*   already queued, and the post-to-start figures grow with the time	*/
+/*   the handler spends after posting.  Needs DWORK 1 (TESTCONF).	*/
+
+#include <xinu.h>
+#include <hostos.h>
+
+#define	NLAT		40	/* Posts timed in the latency phase	*/
+#define	BUSYUS		300	/* us every other handler spends after	*/
+				/*   posting (under the 1 ms tick)	*/
+#define	CNTUS		8	/* us per TIMER2 count (getmicros step)	*/
+#define	MAXLOG		16	/* Entries kept in dwlog		*/
+
+local	void	logwork(void *);
+local	void	rework(void *);
+local	void	nowork(void *);
+
+struct	dwork	wa = DWORK_INIT(logwork, "a");
+struct	dwork	wb = DWORK_INIT(logwork, "b");
+struct	dwork	wc = DWORK_INIT(logwork, "c");
+struct	dwork	wr = DWORK_INIT(rework, "r");
+struct	dwork	wl = DWORK_INIT(nowork, NULL);
+
+int32	fails;			/* Checks that did not hold		*/
+int32	phase;			/* What tickpost does next (0 = nothing) */
+int32	nlat;			/* Posts made in the latency phase	*/
+char	dwlog[MAXLOG + 1];	/* Items in the order they ran		*/
+int32	nlog;			/* Entries in dwlog			*/
+
+/*------------------------------------------------------------------------
+ *  logwork  -  Work function: note which item ran
+ *------------------------------------------------------------------------
+ */
+local	void	logwork(
+	  void		*arg		/* Name of the item		*/
+	)
+{
+	if (nlog < MAXLOG) {
+		dwlog[nlog++] = *(char *)arg;
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  rework  -  Work function that posts its own item twice on its first
+ *	       run: it must run once more, behind what is queued
+ *------------------------------------------------------------------------
+ */
+local	void	rework(
+	  void		*arg		/* Name of the item		*/
+	)
+{
+	logwork(arg);
+	if (wr.dwruns == 1) {
+		if (wr.dwpending || dwpost(&wr) != OK || dwpost(&wr) != OK) {
+			kprintf("dwork: re-post from the work function\n");
+			fails++;
+		}
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  nowork  -  Work function of the latency phase
+ *------------------------------------------------------------------------
+ */
+local	void	nowork(
+	  void		*arg		/* Unused			*/
+	)
+{
+}
+
+/*------------------------------------------------------------------------
+ *  tickpost  -  Interrupt handler: post the items of the current phase
+ *------------------------------------------------------------------------
+ */
+void	tickpost(void)
+{
+	unsigned long long t;
+
+	switch (phase) {
+	case 1:				/* FIFO order and a merge	*/
+		dwpost_isr(&wa);
+		dwpost_isr(&wb);
+		dwpost_isr(&wa);
+		dwpost_isr(&wc);
+		phase = 0;
+		break;
+	case 2:				/* Re-post from dwfunc		*/
+		dwpost_isr(&wr);
+		dwpost_isr(&wb);
+		phase = 0;
+		break;
+	case 3:				/* Latency, every other one	*/
+		dwpost_isr(&wl);	/*   held back BUSYUS		*/
+		if (nlat++ % 2 == 1) {
+			t = hostmicros();
+			while (hostmicros() - t < BUSYUS) {
+				;
+			}
+		}
+		if (nlat >= NLAT) {
+			phase = 0;
+		}
+		break;
+	}
+	isr_exit();
+}
+
+/*------------------------------------------------------------------------
+ *  logis  -  Return TRUE if dwlog holds exactly the given items
+ *------------------------------------------------------------------------
+ */
+local	bool8	logis(
+	  char		*want		/* Items in the order expected	*/
+	)
+{
+	int32	i;
+
+	for (i = 0; want[i] != NULLCH; i++) {
+		if (i >= nlog || dwlog[i] != want[i]) {
+			return FALSE;
+		}
+	}
+	return i == nlog;
+}
+
+/*------------------------------------------------------------------------
+ *  runphase  -  Have tickpost run one phase and wait until it is done;
+ *		 the daemon runs the work before main gets the CPU back
+ *------------------------------------------------------------------------
+ */
+local	void	runphase(
+	  int32		p		/* Phase for tickpost		*/
+	)
+{
+	nlog = 0;
+	memset(dwlog, 0, sizeof(dwlog));
+	phase = p;
+	while (phase != 0) {
+		sleepms(1);
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  main  -  Run the phases from the tick handler and check the results
+ *------------------------------------------------------------------------
+ */
+process	main(void)
+{
+	uint32	avg;			/* Mean post-to-start time	*/
+
+	hostextisr = tickpost;
+
+	runphase(1);
+	if (!logis("abc") || wa.dwruns != 1 || wa.dwmerged != 1
+	    || wb.dwruns != 1 || wc.dwruns != 1 || wc.dwmerged != 0) {
+		kprintf("dwork: ran \"%s\", a %d runs %d merged\n",
+			dwlog, wa.dwruns, wa.dwmerged);
+		fails++;
+	}
+
+	runphase(2);
+	if (!logis("rbr") || wr.dwruns != 2
+	    || wr.dwmerged != 1 || wr.dwpending) {
+		kprintf("dwork: ran \"%s\", r %d runs %d merged\n",
+			dwlog, wr.dwruns, wr.dwmerged);
+		fails++;
+	}
+
+	runphase(3);
+	hostextisr = NULL;
+	dwreport(&wl, "dwork");
+	avg = wl.dwruns ? wl.dwtotlat / wl.dwruns : 0;
+	if (wl.dwruns != NLAT || wl.dwmerged != 0) {
+		kprintf("dwork: %d runs, %d merged of %d posts\n",
+			wl.dwruns, wl.dwmerged, NLAT);
+		fails++;
+	}
+	if (wl.dwmaxlat < BUSYUS - CNTUS || avg > wl.dwmaxlat
+	    || wl.dwtotlat < (NLAT / 2) * (BUSYUS - CNTUS)) {
+		kprintf("dwork: latency avg %d max %d us, %d held %d us\n",
+			avg, wl.dwmaxlat, NLAT / 2, BUSYUS);
+		fails++;
+	}
+
+	kprintf("dwork: %s\n", fails == 0 ? "ok" : "FAILED");
+	hostexit(fails);
+	return OK;
+}
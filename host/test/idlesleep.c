@@ -0,0 +1,88 @@
+/* idlesleep.c - main, sleeper (host test) */
+
+/* Sleep accuracy with the tickless idle (built with TICKLESS=1, see	*/
+/*   ../Makefile).  A sleeper starts each sleep at a TCNT2 that the 8	*/
+/*   times coarser idle count cannot hold, so stretching the tick must	*/
+/*   carry those counts to clkresume.  No sleep may end early, and the	*/
+/*   kernel clock (getmicros) must keep up with the host clock across	*/
+/*   a sleep.  Each switch back to the 1 ms tick also drops the time	*/
+/*   since the last idle count, up to 64 us of host latency, so the	*/
+/*   smallest loss over all sleeps is the one that is checked.		*/
+
+#include <xinu.h>
+#include <hostos.h>
+
+#define	NSLEEPS		200	/* Sleeps timed				*/
+#define	SLEEPMS		20	/* Length of each: one idle period of	*/
+				/*   16 ms, then 1 ms ticks		*/
+#define	STARTUS		496	/* Start sleeps at TCNT2 62 or 63, 6 or	*/
+#define	STARTWIN	8	/*   7 counts below the idle resolution	*/
+#define	MAXLOSSUS	24	/* Allowed smallest clock loss: half of	*/
+				/*   what dropping 6 counts would give	*/
+
+int32	fails;			/* Checks that did not hold		*/
+sid32	semdone;		/* Signalled when the sleeper finishes	*/
+
+/*------------------------------------------------------------------------
+ *  sleeper  -  Time each sleep with the host and the kernel clocks
+ *------------------------------------------------------------------------
+ */
+process	sleeper(void)
+{
+	int32	i;
+	unsigned long long t;		/* hostmicros() before a sleep	*/
+	uint32	k;			/* getmicros() before a sleep	*/
+	int32	us;			/* Sleep length by the host	*/
+	int32	loss;			/* Host minus kernel length	*/
+	int32	minloss = 0x7fffffff;	/* Smallest loss of any sleep	*/
+
+	for (i = 0; i < NSLEEPS; i++) {
+		while (getmicros() % 1000 - STARTUS >= STARTWIN) {
+			;
+		}
+		t = hostmicros();
+		k = getmicros();
+		sleepms(SLEEPMS);
+		us = hostmicros() - t;
+		loss = us - (int32)(getmicros() - k);
+
+		/* The sleep started STARTUS into a tick and ends on a	*/
+		/*   tick boundary, which the host may only see later	*/
+
+		if (us < SLEEPMS * 1000 - STARTUS - STARTWIN) {
+			kprintf("idlesleep: sleepms(%d) took %d us\n",
+				SLEEPMS, us);
+			fails++;
+		}
+		if (loss < minloss) {
+			minloss = loss;
+		}
+	}
+
+	kprintf("idlesleep: %d sleeps, kernel clock lost at least %d us\n",
+		NSLEEPS, minloss);
+	if (minloss > MAXLOSSUS) {
+		fails++;
+	}
+	signal(semdone);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  main  -  Run the sleeper with nothing else ready, so that the null
+ *	     process stretches the tick for every sleep
+ *------------------------------------------------------------------------
+ */
+process	main(void)
+{
+#if !TICKLESS
+	kprintf("idlesleep: needs TICKLESS 1\n");
+	hostexit(1);
+#endif
+	semdone = semcreate(0);
+	resume(create(sleeper, 512, INITPRIO + 1, "sleeper", 0));
+	wait(semdone);
+	kprintf("idlesleep: %s\n", fails == 0 ? "ok" : "FAILED");
+	hostexit(fails);
+	return OK;
+}
@@ -0,0 +1,51 @@
+/* klog.c - main (host test) */
+
+/* Round trip of the binary log: records are queued with klog(), sent	*/
+/*   by the log daemon through CONSOLE (the host UART model writes	*/
+/*   them to standard output) and decoded by tools/klogdec, which the	*/
+/*   Makefile runs on the output and compares with test/klog.expect.	*/
+/*   Covers %d %u %lx and %%, and a burst that overflows the ring and	*/
+/*   must come out as a lost record (fmt 0).  Needs KLOG 1 (TESTCONF).	*/
+
+#include <xinu.h>
+#include <hostos.h>
+
+#define	NBURST		12	/* Records logged without a pause;	*/
+				/*   KLOGLEN / 8 of them fit		*/
+#define	DRAINMS		500	/* Time for the daemon and the UART	*/
+				/*   (a byte a ms) to send everything	*/
+
+int32	fails;			/* Checks that did not hold		*/
+
+/*------------------------------------------------------------------------
+ *  main  -  Log the records, wait until they are out and check that
+ *	     the tty output queue emptied
+ *------------------------------------------------------------------------
+ */
+process	main(void)
+{
+	int32	i;
+
+	klog("d %d u %u lx %lx pct %%\n", -5, 40000, 0xdeadbeefUL);
+	sleepms(DRAINMS);
+
+	/* Each record is a 6-byte header and one int: the ring takes	*/
+	/*   KLOGLEN / 8 and the rest are counted as lost, then reported	*/
+	/*   by the first record that finds room			*/
+
+	for (i = 0; i < NBURST; i++) {
+		klog("n %d\n", i);
+	}
+	sleepms(DRAINMS);
+	klog("after %d\n", 1);
+	sleepms(DRAINMS);
+
+	if (ttytab[0].tyohead != ttytab[0].tyotail) {
+		kprintf("klog: %d bytes still queued on CONSOLE\n",
+			(byte)(ttytab[0].tyotail - ttytab[0].tyohead));
+		fails++;
+	}
+	kprintf("klog: %s\n", fails == 0 ? "ok" : "FAILED");
+	hostexit(fails);
+	return OK;
+}
@@ -0,0 +1,220 @@
+/* mqueue.c - main, sender, receiver, tickput, delayed (host test) */
+
+/* Checks the message queue: slots reused in order after mqhead wraps	*/
+/*   past mqdepth, a sender blocking on a full queue until a message	*/
+/*   is taken, mq_recv_timeout returning TIMEOUT and then OK, and	*/
+/*   mq_send_isr from a tick handler refusing on a full queue (counted	*/
+/*   in mqfull) without taking a slot.  mq_highwater is checked along	*/
+/*   the way.								*/
+
+#include <xinu.h>
+#include <hostos.h>
+
+#define	DEPTH		3	/* Slots in the queue under test	*/
+#define	NROUNDS		(4 * DEPTH + 1)	/* Messages in the wrap test	*/
+#define	NREFUSE		5	/* Refused mq_send_isr calls to wait for */
+
+MQ_DEFINE(mq, sizeof(uint16), DEPTH);
+
+int32	fails;			/* Checks that did not hold		*/
+bool8	sent;			/* The blocked sender got through	*/
+uint16	got;			/* Message the receiver process took	*/
+uint16	nisr;			/* Messages mq_send_isr accepted	*/
+uint16	nrefused;		/* mq_send_isr calls that failed	*/
+
+/*------------------------------------------------------------------------
+ *  expect  -  Receive one message and compare it
+ *------------------------------------------------------------------------
+ */
+local	void	expect(
+	  uint16	want,		/* Message that should come	*/
+	  char		*what		/* Check being made		*/
+	)
+{
+	uint16	v;
+
+	if (mq_recv(&mq, &v) != OK || v != want) {
+		kprintf("mqueue: %s: got %d, expected %d\n", what, v, want);
+		fails++;
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  check  -  Compare the queue's count and semaphores with what the
+ *	      test expects
+ *------------------------------------------------------------------------
+ */
+local	void	check(
+	  int32		count,		/* Messages that should be queued */
+	  char		*what		/* Check being made		*/
+	)
+{
+	if (mq.mqcount != count || semcount(mq.mqitems) != count
+	    || semcount(mq.mqspaces) != DEPTH - count) {
+		kprintf("mqueue: %s: %d queued, items %d, spaces %d\n",
+			what, mq.mqcount, semcount(mq.mqitems),
+			semcount(mq.mqspaces));
+		fails++;
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  sender  -  Send one message, blocking if the queue is full
+ *------------------------------------------------------------------------
+ */
+process	sender(void)
+{
+	uint16	v = 100;
+
+	mq_send(&mq, &v);
+	sent = TRUE;
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  receiver  -  Take one message, blocking until there is one
+ *------------------------------------------------------------------------
+ */
+process	receiver(void)
+{
+	mq_recv(&mq, &got);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  delayed  -  Send one message a little later
+ *------------------------------------------------------------------------
+ */
+process	delayed(void)
+{
+	uint16	v = 200;
+
+	sleepms(10);
+	mq_send(&mq, &v);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  tickput  -  Interrupt handler: send the next number, counting the
+ *		refusals once the queue is full
+ *------------------------------------------------------------------------
+ */
+void	tickput(void)
+{
+	if (mq_send_isr(&mq, &nisr) == SYSERR) {
+		nrefused++;
+	} else {
+		nisr++;
+	}
+	isr_exit();
+}
+
+/*------------------------------------------------------------------------
+ *  main  -  Run the checks in turn on the one queue
+ *------------------------------------------------------------------------
+ */
+process	main(void)
+{
+	uint16	i;
+	uint16	v;
+	pid32	pid;
+
+	if (mq_init(&mq) != OK) {
+		panic("mqueue: init");
+	}
+
+	/* Two queued at a time: the slots wrap several times over */
+
+	for (i = 0; i < NROUNDS; i++) {
+		mq_send(&mq, &i);
+		if (i > 0) {
+			expect(i - 1, "wrap");
+		}
+	}
+	expect(NROUNDS - 1, "wrap");
+	check(0, "after wrap");
+	if (mq_highwater(&mq) != 2) {
+		kprintf("mqueue: high water %d after wrap, not 2\n",
+			mq_highwater(&mq));
+		fails++;
+	}
+
+	/* A sender on a full queue blocks until a slot is freed, and	*/
+	/*   its message goes in behind the ones already there		*/
+
+	for (i = 0; i < DEPTH; i++) {
+		mq_send(&mq, &i);
+	}
+	pid = create(sender, 256, INITPRIO + 1, "sender", 0);
+	resume(pid);
+	if (sent || proctab[pid].prstate != PR_WAIT) {
+		kprintf("mqueue: sender did not block on a full queue\n");
+		fails++;
+	}
+	expect(0, "full");		/* Sender runs at once		*/
+	if (!sent) {
+		kprintf("mqueue: sender still blocked after a receive\n");
+		fails++;
+	}
+	check(DEPTH, "sender unblocked");
+	for (i = 1; i < DEPTH; i++) {
+		expect(i, "full");
+	}
+	expect(100, "blocked sender");
+	if (mq_highwater(&mq) != DEPTH) {
+		kprintf("mqueue: high water %d, not %d\n",
+			mq_highwater(&mq), DEPTH);
+		fails++;
+	}
+
+	/* Timed receive: nothing comes, then a message arrives during	*/
+	/*   the wait, then one is already there			*/
+
+	if (mq_recv_timeout(&mq, &v, 20) != TIMEOUT) {
+		kprintf("mqueue: empty queue did not time out\n");
+		fails++;
+	}
+	check(0, "after timeout");
+	resume(create(delayed, 256, INITPRIO, "delayed", 0));
+	if (mq_recv_timeout(&mq, &v, 1000) != OK || v != 200) {
+		kprintf("mqueue: timed receive missed a message\n");
+		fails++;
+	}
+	v = 300;
+	mq_send(&mq, &v);
+	v = 0;
+	if (mq_recv_timeout(&mq, &v, 0) != OK || v != 300) {
+		kprintf("mqueue: poll missed a queued message\n");
+		fails++;
+	}
+	check(0, "after timed receives");
+
+	/* From the tick handler: the first message wakes a blocked	*/
+	/*   receiver, then the queue fills and further sends are	*/
+	/*   refused without taking a slot				*/
+
+	resume(create(receiver, 256, INITPRIO + 1, "receiver", 0));
+	hostextisr = tickput;
+	while (nrefused < NREFUSE) {
+		sleepms(1);
+	}
+	hostextisr = NULL;
+	if (got != 0 || nisr != DEPTH + 1) {
+		kprintf("mqueue: receiver got %d, %d sent from the ISR\n",
+			got, nisr);
+		fails++;
+	}
+	if (mq.mqfull != nrefused) {
+		kprintf("mqueue: mqfull %d, %d refused\n", mq.mqfull, nrefused);
+		fails++;
+	}
+	check(DEPTH, "ISR on a full queue");
+	for (i = 1; i <= DEPTH; i++) {
+		expect(i, "ISR");
+	}
+	check(0, "after ISR");
+
+	kprintf("mqueue: %s\n", fails == 0 ? "ok" : "FAILED");
+	hostexit(fails);
+	return OK;
+}
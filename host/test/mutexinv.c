@@ -0,0 +1,152 @@
+/* mutexinv.c - main, low, mid, high (host test) */
+
+/* Priority inversion with mutexes (built with NMUTEX=2, see		*/
+/*   ../Makefile).  low takes a mutex, starts high, which blocks on	*/
+/*   it, and then starts mid.  Without inheritance mid would run	*/
+/*   before low could release the mutex, keeping high waiting; with	*/
+/*   it low runs at high's priority until mutunlock.  Each process	*/
+/*   appends a letter to a log whose order is then compared with the	*/
+/*   expected one, and low's priority is checked at each step.  A	*/
+/*   mutex with a ceiling must raise its owner while held.		*/
+
+#include <xinu.h>
+#include <hostos.h>
+
+#define	LOWPRIO		(INITPRIO + 10)	/* All above main, which only	*/
+#define	MIDPRIO		(INITPRIO + 20)	/*   waits for them		*/
+#define	HIGHPRIO	(INITPRIO + 30)
+#define	CEILING		(INITPRIO + 25)
+
+#define	EXPECTED	"LhHUGmE"	/* Order of events, see below	*/
+
+mid16	mut;			/* Mutex the three processes share	*/
+pid32	midpid, highpid;	/* Processes low starts			*/
+char	events[16];		/* Letters in the order logged		*/
+int32	nevents;
+int32	fails;			/* Checks that did not hold		*/
+sid32	semdone;		/* Signalled when low finishes		*/
+
+/*------------------------------------------------------------------------
+ *  logevent  -  Append an event letter to the log
+ *------------------------------------------------------------------------
+ */
+local	void	logevent(
+	  char		c		/* Event			*/
+	)
+{
+	if (nevents < (int32)sizeof(events) - 1) {
+		events[nevents++] = c;
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  checkprio  -  Compare the caller's priority with the one expected
+ *------------------------------------------------------------------------
+ */
+local	void	checkprio(
+	  char		*when,		/* Step, for the message	*/
+	  pri16		expect		/* Priority it should have	*/
+	)
+{
+	pri16	prio = getprio(getpid());
+
+	if (prio != expect) {
+		kprintf("mutexinv: %s: priority %d, expected %d\n",
+			when, prio, expect);
+		fails++;
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  high  -  Block on the mutex low holds (h), get it (G)
+ *------------------------------------------------------------------------
+ */
+process	high(void)
+{
+	logevent('h');
+	if (mutlock(mut) != OK) {
+		fails++;
+	}
+	logevent('G');
+	mutunlock(mut);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  mid  -  Middle priority work that must wait for high (m)
+ *------------------------------------------------------------------------
+ */
+process	mid(void)
+{
+	logevent('m');
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  low  -  Hold the mutex (L) while high blocks on it (H) and mid
+ *	    becomes ready, release it (U) and finish (E)
+ *------------------------------------------------------------------------
+ */
+process	low(void)
+{
+	mutlock(mut);
+	logevent('L');
+	checkprio("holding", LOWPRIO);
+
+	resume(highpid);		/* Blocks on mut at once	*/
+	logevent('H');
+	checkprio("high waiting", HIGHPRIO);
+
+	resume(midpid);			/* Must not run yet		*/
+	logevent('U');
+	mutunlock(mut);			/* high runs, then mid		*/
+
+	logevent('E');
+	checkprio("released", LOWPRIO);
+	signal(semdone);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  main  -  Run the inversion scenario, then check a ceiling mutex
+ *------------------------------------------------------------------------
+ */
+process	main(void)
+{
+	mid16	ceil;			/* Mutex with a ceiling		*/
+
+#if NMUTEX < 2
+	kprintf("mutexinv: needs NMUTEX 2\n");
+	hostexit(1);
+#endif
+	semdone = semcreate(0);
+	mut = mutcreate(MUNOCEIL);
+	highpid = create(high, 512, HIGHPRIO, "high", 0);
+	midpid = create(mid, 512, MIDPRIO, "mid", 0);
+	if (mut == SYSERR || highpid == SYSERR || midpid == SYSERR) {
+		panic("mutexinv: create");
+	}
+	resume(create(low, 512, LOWPRIO, "low", 0));
+	wait(semdone);
+
+	events[nevents] = NULLCH;
+	kprintf("mutexinv: events %s, expected %s\n", events, EXPECTED);
+	if (strncmp(events, EXPECTED, sizeof(events)) != 0) {
+		fails++;
+	}
+
+	/* The owner of a ceiling mutex runs at the ceiling until it	*/
+	/*   unlocks, then at its own priority again			*/
+
+	ceil = mutcreate(CEILING);
+	if (mutlock(ceil) != OK) {
+		fails++;
+	}
+	checkprio("ceiling held", CEILING);
+	mutunlock(ceil);
+	checkprio("ceiling released", INITPRIO);
+
+	kprintf("mutexinv: %s\n", fails == 0 ? "ok" : "FAILED");
+	hostexit(fails);
+	return OK;
+}
@@ -0,0 +1,94 @@
+/* ringisr.c - main, producer, consumer (host test) */
+
+/* Stress test of a blocking ring fed from an interrupt handler: the	*/
+/*   producer runs as a second interrupt source on every tick (see	*/
+/*   hostextisr) and puts a numbered burst with name_put_isr(); the	*/
+/*   consumer blocks in name_getw() and now and then stalls so that	*/
+/*   the ring fills.  Every value must arrive once and in order, and	*/
+/*   the consumer must never stay blocked with data in the ring.	*/
+
+#include <xinu.h>
+#include <hostos.h>
+
+#define	NITEMS		20000	/* Values the producer hands over	*/
+#define	BURST		7	/* Puts per interrupt			*/
+#define	STALLEVERY	500	/* Values between consumer stalls	*/
+#define	STALLUS		5000	/* Length of a stall (us)		*/
+
+RING_DEFINE(sq, uint16, 16)
+
+struct	sq	ring;		/* Ring under test			*/
+uint16	nput;			/* Values put so far (next to put)	*/
+uint16	nfull;			/* Puts refused because ring was full	*/
+sid32	semdone;		/* Signalled when the consumer finishes	*/
+int32	fails;			/* Checks that did not hold		*/
+
+/*------------------------------------------------------------------------
+ *  producer  -  Interrupt handler: put a burst of consecutive values
+ *------------------------------------------------------------------------
+ */
+void	producer(void)
+{
+	int32	i;
+
+	for (i = 0; i < BURST && nput < NITEMS; i++) {
+		if (!sq_put_isr(&ring, nput)) {
+			nfull++;
+			break;
+		}
+		nput++;
+	}
+	isr_exit();
+}
+
+/*------------------------------------------------------------------------
+ *  consumer  -  Take every value, check the sequence, stall sometimes
+ *------------------------------------------------------------------------
+ */
+process	consumer(void)
+{
+	uint16	v;			/* Value taken from the ring	*/
+	uint16	expect;			/* Value that should come next	*/
+	unsigned long long t;
+
+	for (expect = 0; expect < NITEMS; expect++) {
+		sq_getw(&ring, &v);
+		if (v != expect) {
+			kprintf("ringisr: got %d, expected %d\n", v, expect);
+			fails++;
+			break;
+		}
+		if (expect % STALLEVERY == 0) {
+			t = hostmicros();
+			while (hostmicros() - t < STALLUS) {
+				;
+			}
+		}
+	}
+	signal(semdone);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  main  -  Start the consumer, attach the producer and wait
+ *------------------------------------------------------------------------
+ */
+process	main(void)
+{
+	semdone = semcreate(0);
+	if (sq_init(&ring, TRUE) != OK) {
+		panic("ringisr: init");
+	}
+	resume(create(consumer, 256, INITPRIO + 1, "consumer", 0));
+	hostextisr = producer;
+	if (waittime(semdone, 30000) != OK) {
+		kprintf("ringisr: consumer stuck after %d values\n", nput);
+		fails++;
+	}
+	hostextisr = NULL;
+	kprintf("ringisr: %d values, %d puts refused on a full ring\n",
+		nput, nfull);
+	kprintf("ringisr: %s\n", fails == 0 ? "ok" : "FAILED");
+	hostexit(fails);
+	return OK;
+}
@@ -0,0 +1,160 @@
+/* semfifo.c - main, waiter, onqueue, startwaiters (host test) */
+
+/* Timed waiters (waittime) are kept on sleepq rather than on the	*/
+/*   semaphore queue; checks that signal() still releases timed and	*/
+/*   untimed waiters in the order they arrived, whatever their process	*/
+/*   IDs, that a timeout gives the count back, and that killing a timed	*/
+/*   waiter gives back its count and its place in the ticket order.	*/
+
+#include <xinu.h>
+#include <hostos.h>
+
+#define	NWAITERS	(NPROC - 2) /* All but null and main; even	*/
+				/*   ones use waittime, odd ones wait	*/
+#define	LONGWAIT	10000	/* ms; long enough never to expire	*/
+
+sid32	sem;			/* Semaphore the waiters block on	*/
+int32	narrived;		/* Waiters that have started to wait	*/
+int32	nreleased;		/* Waiters that have been released	*/
+int32	arrived[NWAITERS];	/* Waiter numbers in arrival order	*/
+int32	released[NWAITERS];	/* Waiter numbers in release order	*/
+int32	fails;			/* Checks that did not hold		*/
+pid32	pids[NWAITERS];		/* Process of each waiter		*/
+
+/*------------------------------------------------------------------------
+ *  waiter  -  Wait on sem, timed or not depending on the waiter number
+ *------------------------------------------------------------------------
+ */
+process	waiter(void)
+{
+	int32	me;			/* Waiter number		*/
+
+	for (me = 0; pids[me] != getpid(); me++) {
+		;
+	}
+	arrived[narrived++] = me;
+	if (me % 2 == 0) {
+		if (waittime(sem, LONGWAIT) != OK) {
+			kprintf("semfifo: waiter %d timed out\n", me);
+			fails++;
+		}
+	} else {
+		wait(sem);
+	}
+	released[nreleased++] = me;
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  onqueue  -  Return TRUE if a process is linked on a queue
+ *------------------------------------------------------------------------
+ */
+local	bool8	onqueue(
+	  pid32		pid,		/* Process to look for		*/
+	  qid16		q		/* Queue to walk		*/
+	)
+{
+	qid16	i;
+
+	for (i = firstid(q); i != queuetail(q); i = queuetab[i].qnext) {
+		if (i == pid) {
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/*------------------------------------------------------------------------
+ *  startwaiters  -  Create the waiters, suspended, and clear the logs
+ *------------------------------------------------------------------------
+ */
+local	void	startwaiters(void)
+{
+	int32	i;
+
+	narrived = nreleased = 0;
+	for (i = 0; i < NWAITERS; i++) {
+		arrived[i] = released[i] = -1;
+		pids[i] = create(waiter, 256, INITPRIO + 1, "waiter", 0);
+		if (pids[i] == SYSERR) {
+			panic("semfifo: create");
+		}
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  main  -  Queue the waiters in reverse pid order, release them one at
+ *	     a time and compare the orders
+ *------------------------------------------------------------------------
+ */
+process	main(void)
+{
+	int32	i;
+
+	sem = semcreate(0);
+	startwaiters();
+	for (i = NWAITERS - 1; i >= 0; i--) {
+		resume(pids[i]);	/* Runs and blocks at once	*/
+	}
+	for (i = 0; i < NWAITERS; i++) {
+		signal(sem);		/* Released one runs at once	*/
+	}
+	for (i = 0; i < NWAITERS; i++) {
+		if (released[i] != arrived[i]) {
+			kprintf("semfifo: release %d is waiter %d, not %d\n",
+				i, released[i], arrived[i]);
+			fails++;
+		}
+	}
+
+	/* A timeout must leave the count as it was */
+
+	if (waittime(sem, 20) != TIMEOUT || semcount(sem) != 0) {
+		kprintf("semfifo: timeout did not restore the count\n");
+		fails++;
+	}
+	signal(sem);
+	if (waittime(sem, 20) != OK || semcount(sem) != 0) {
+		kprintf("semfifo: signal before waittime was lost\n");
+		fails++;
+	}
+
+	/* Kill a timed waiter queued between a timed and an untimed	*/
+	/*   one: its count and its timed-waiter mark must come back, it	*/
+	/*   must be off every queue, and the next two signals must	*/
+	/*   still release the other two in arrival order		*/
+
+	startwaiters();
+	resume(pids[0]);		/* Timed			*/
+	resume(pids[2]);		/* Timed, to be killed		*/
+	resume(pids[1]);		/* Untimed			*/
+	if (semcount(sem) != -3 || semtab[sem].stimed != 2) {
+		kprintf("semfifo: count %d, %d timed before the kill\n",
+			semcount(sem), semtab[sem].stimed);
+		fails++;
+	}
+	kill(pids[2]);
+	if (semcount(sem) != -2 || semtab[sem].stimed != 1) {
+		kprintf("semfifo: count %d, %d timed after the kill\n",
+			semcount(sem), semtab[sem].stimed);
+		fails++;
+	}
+	if (proctab[pids[2]].prstate != PR_FREE
+	    || onqueue(pids[2], sleepq)
+	    || onqueue(pids[2], semtab[sem].squeue)) {
+		kprintf("semfifo: killed waiter still queued\n");
+		fails++;
+	}
+	signal(sem);
+	signal(sem);
+	if (nreleased != 2 || released[0] != 0 || released[1] != 1
+	    || semcount(sem) != 0 || semtab[sem].stimed != 0) {
+		kprintf("semfifo: after the kill released %d, %d (%d)\n",
+			released[0], released[1], nreleased);
+		fails++;
+	}
+
+	kprintf("semfifo: %s\n", fails == 0 ? "ok" : "FAILED");
+	hostexit(fails);
+	return OK;
+}
@@ -0,0 +1,64 @@
+/* sleeplong.c - main, sleeper (host test) */
+
+/* Sleeps longer than the 16-bit delta keys hold are queued in		*/
+/*   SLCHUNK pieces (see insertd and wakeup); checks against the host	*/
+/*   clock that each one lasts as long as asked, with a sleeper of	*/
+/*   one, two and three extra pieces running at the same time.	*/
+
+#include <xinu.h>
+#include <hostos.h>
+
+#define	NSLEEPERS	3
+#define	MAXERRPCT	5	/* Allowed error of each sleep in %:	*/
+				/*   the host timer drops a few ticks	*/
+				/*   under load, and the bug this test	*/
+				/*   guards against was off by half	*/
+
+local	const uint32	delays[NSLEEPERS] = { 40000, 66000, 99000 };
+
+int32	nextdelay;		/* Index of the next sleeper's delay	*/
+int32	fails;			/* Sleeps that ended at the wrong time	*/
+sid32	semdone;		/* Signalled by each sleeper at the end	*/
+
+/*------------------------------------------------------------------------
+ *  sleeper  -  Sleep for the next delay and check how long it took
+ *------------------------------------------------------------------------
+ */
+process	sleeper(void)
+{
+	uint32	ms;			/* Delay to sleep		*/
+	unsigned long long t0, t;	/* hostmicros() around the sleep*/
+	int32	err;			/* Error in milliseconds	*/
+
+	ms = delays[nextdelay++];
+	t0 = hostmicros();
+	sleepms(ms);
+	t = hostmicros() - t0;
+	err = (int32)(t / 1000) - (int32)ms;
+	kprintf("sleeplong: sleepms(%u) took %llu ms\n", ms, t / 1000);
+	if (err < -2 || err > (int32)(ms / 100 * MAXERRPCT)) {
+		fails++;
+	}
+	signal(semdone);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  main  -  Start the sleepers and wait for all of them
+ *------------------------------------------------------------------------
+ */
+process	main(void)
+{
+	int32	i;
+
+	semdone = semcreate(0);
+	for (i = 0; i < NSLEEPERS; i++) {
+		resume(create(sleeper, 256, INITPRIO + 1, "sleeper", 0));
+	}
+	for (i = 0; i < NSLEEPERS; i++) {
+		wait(semdone);
+	}
+	kprintf("sleeplong: %s\n", fails == 0 ? "ok" : "FAILED");
+	hostexit(fails);
+	return OK;
+}
@@ -0,0 +1,100 @@
+/* stkusage.c - main, user, touch (host test) */
+
+/* Checks stkusage(): two processes touch a known number of stack	*/
+/*   bytes and stay alive while main reads their high-water marks,	*/
+/*   which must cover what was touched and grow with it; the guard	*/
+/*   bytes must still be intact and a bad process ID must give SYSERR.	*/
+/*   The marks also include the frames of calls and of the interrupt	*/
+/*   handler, so only lower bounds are exact.				*/
+
+#include <xinu.h>
+#include <hostos.h>
+
+#define	SMALL		1000	/* Bytes touched by the first process	*/
+#define	LARGE		6000	/* Bytes touched by the second		*/
+#define	USERSTK		8192	/* Stack asked for each process		*/
+
+int32	nbytes;			/* Bytes the next user touches		*/
+sid32	semtouched;		/* Signalled by a user after touching	*/
+sid32	semexit;		/* Lets the users finish		*/
+
+/*------------------------------------------------------------------------
+ *  touch  -  Write n bytes of a local array so they leave the paint
+ *------------------------------------------------------------------------
+ */
+local	byte	__attribute__((noinline)) touch(
+	  int32		n		/* Bytes to touch		*/
+	)
+{
+	volatile byte	buf[LARGE];	/* Stack area being touched	*/
+	int32	i;
+
+	for (i = 0; i < n; i++) {
+		buf[LARGE - 1 - i] = (byte)(STKPAINT + 1);
+	}
+	return buf[LARGE - 1];
+}
+
+/*------------------------------------------------------------------------
+ *  user  -  Touch nbytes of stack, then wait to be measured
+ *------------------------------------------------------------------------
+ */
+process	user(void)
+{
+	touch(nbytes);
+	signal(semtouched);
+	wait(semexit);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  main  -  Start two users and compare their stack usage
+ *------------------------------------------------------------------------
+ */
+process	main(void)
+{
+	pid32	small, large;		/* The two user processes	*/
+	int32	usmall, ularge;		/* Their stkusage() values	*/
+	int32	fails = 0;		/* Checks that did not hold	*/
+
+	semtouched = semcreate(0);
+	semexit = semcreate(0);
+
+	nbytes = SMALL;
+	small = create(user, USERSTK, INITPRIO + 1, "small", 0);
+	if (stkusage(small) > CONTEXT) {
+		kprintf("stkusage: %d bytes used before running\n",
+			stkusage(small));
+		fails++;
+	}
+	resume(small);
+	wait(semtouched);
+
+	nbytes = LARGE;
+	large = create(user, USERSTK, INITPRIO + 1, "large", 0);
+	resume(large);
+	wait(semtouched);
+
+	usmall = stkusage(small);
+	ularge = stkusage(large);
+	kprintf("stkusage: %d bytes touched -> %d, %d -> %d\n",
+		SMALL, usmall, LARGE, ularge);
+	if (usmall < SMALL || ularge < LARGE
+	    || ularge - usmall < LARGE - SMALL) {
+		fails++;
+	}
+	if (!stkcheck(&proctab[small]) || !stkcheck(&proctab[large])) {
+		kprintf("stkusage: guard bytes overwritten\n");
+		fails++;
+	}
+	if (stkusage(-1) != SYSERR || stkusage(NPROC) != SYSERR) {
+		kprintf("stkusage: no SYSERR for a bad process ID\n");
+		fails++;
+	}
+
+	signal(semexit);
+	signal(semexit);
+	kprintf("stkusage: %s\n", fails == 0 ? "ok" : "FAILED");
+	hostexit(fails);
+	return OK;
+}
@@ -0,0 +1,49 @@
+/* types.c - main (host test) */
+
+/* Checks the assumptions the host build makes about the kernel types:	*/
+/*   the fixed-size integers have the AVR widths and wrap as there,	*/
+/*   and heap and stack addresses survive a trip through uint32.	*/
+
+#include <xinu.h>
+#include <hostos.h>
+
+/*------------------------------------------------------------------------
+ *  main  -  Run the checks and exit with the number that failed
+ *------------------------------------------------------------------------
+ */
+process	main(void)
+{
+	int32	fails = 0;		/* Checks that did not hold	*/
+	uint32	t;			/* A time just before wrapping	*/
+	char	*blk;			/* Block from getmem()		*/
+	char	*stk;			/* Top of a stack from getstk()	*/
+
+	if (sizeof(int16) != 2 || sizeof(uint16) != 2
+	    || sizeof(int32) != 4 || sizeof(uint32) != 4) {
+		kprintf("types: int16/int32 are %d/%d bytes\n",
+			(int)sizeof(int16), (int)sizeof(int32));
+		fails++;
+	}
+
+	/* Deadlines compared as the clock code does across a wrap */
+
+	t = 0xfffffff0;
+	if (!((int32)((t + 0x20) - t) > 0) || (uint32)(t + 0x20) != 0x10) {
+		kprintf("types: uint32 does not wrap at 32 bits\n");
+		fails++;
+	}
+
+	blk = getmem(32);
+	stk = getstk(256);
+	if ((char *)(uint32)blk != blk || (char *)(uint32)stk != stk) {
+		kprintf("types: heap address %p does not fit in uint32\n",
+			blk);
+		fails++;
+	}
+	freemem(blk, 32);
+	freestk(stk, 256);
+
+	kprintf("types: %s\n", fails == 0 ? "ok" : "FAILED");
+	hostexit(fails);
+	return OK;
+}
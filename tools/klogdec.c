@@ -0,0 +1,308 @@
+/* klogdec.c - decode a Xinu-AVR klog capture (host tool)
+ *
+ * Reads the records sent by the log daemon when the kernel is built
+ * with KLOG set (see include/klog.h) and prints each one as text, with
+ * the format string taken from the flash image in the ELF file that is
+ * running on the board.
+ *
+ *	cc -O2 -o klogdec klogdec.c
+ *	cat /dev/ttyUSB0 > capture.bin
+ *	klogdec xinu.elf capture.bin
+ *
+ * Each line starts with the time in seconds since boot, rebuilt from
+ * the low half of clkticks, so records must be less than 65 s apart
+ * for the time to stay right.
+ *
+ * The ELF64 program of the host port (host/) is read as well: there a
+ * record holds the low half of the format's address, and the formats
+ * are linked into the .klfmt section, which lies within one 64 KB
+ * block (see host/include/klog.h); the high half is taken from it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define	KLSYNC		0xa5	/* Must match include/klog.h		*/
+#define	KLHDR		6
+
+#define	SHT_PROGBITS	1	/* ELF constants used below		*/
+#define	SHF_ALLOC	2
+
+static unsigned char	*elf;	/* Whole ELF file			*/
+static long	elflen;
+static int	elf64;		/* ELF64 (host port), not ELF32 (AVR)	*/
+
+struct sect {			/* Fields of one section header		*/
+	unsigned long	name, type, flags;
+	unsigned long long	addr, off, size;
+};
+
+static unsigned get16(const unsigned char *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+static unsigned long get32(const unsigned char *p)
+{
+	return get16(p) | ((unsigned long)get16(p + 2) << 16);
+}
+
+static unsigned long long get64(const unsigned char *p)
+{
+	return get32(p) | ((unsigned long long)get32(p + 4) << 32);
+}
+
+/* Load the ELF file and check it is a little-endian image */
+
+static int loadelf(const char *name)
+{
+	FILE	*f;
+
+	if ((f = fopen(name, "rb")) == NULL) {
+		perror(name);
+		return -1;
+	}
+	fseek(f, 0, SEEK_END);
+	elflen = ftell(f);
+	rewind(f);
+	elf = malloc(elflen);
+	if (elf == NULL || fread(elf, 1, elflen, f) != (size_t)elflen) {
+		fprintf(stderr, "klogdec: cannot read %s\n", name);
+		fclose(f);
+		return -1;
+	}
+	fclose(f);
+	if (elflen < 64 || memcmp(elf, "\177ELF", 4) != 0
+	    || (elf[4] != 1 && elf[4] != 2) || elf[5] != 1) {
+		fprintf(stderr, "klogdec: %s is not an ELF LE file\n", name);
+		return -1;
+	}
+	elf64 = (elf[4] == 2);
+	return 0;
+}
+
+/* Read section header i; return -1 if it is outside the file */
+
+static int getsect(unsigned i, struct sect *s)
+{
+	unsigned long long	shoff;
+	unsigned	shentsize;
+	const unsigned char	*sh;
+
+	shoff = elf64 ? get64(elf + 40) : get32(elf + 32);
+	shentsize = get16(elf + (elf64 ? 58 : 46));
+	sh = elf + shoff + (unsigned long long)i * shentsize;
+	if (sh + (elf64 ? 64 : 40) > elf + elflen) {
+		return -1;
+	}
+	s->name = get32(sh);
+	s->type = get32(sh + 4);
+	if (elf64) {
+		s->flags = get64(sh + 8);
+		s->addr = get64(sh + 16);
+		s->off = get64(sh + 24);
+		s->size = get64(sh + 32);
+	} else {
+		s->flags = get32(sh + 8);
+		s->addr = get32(sh + 12);
+		s->off = get32(sh + 16);
+		s->size = get32(sh + 20);
+	}
+	return 0;
+}
+
+/* Return the address of the host's .klfmt section, or 0 */
+
+static unsigned long long klfmtaddr(void)
+{
+	unsigned	shnum = get16(elf + 60);
+	struct sect	s, names;
+
+	if (getsect(get16(elf + 62), &names) != 0) {
+		return 0;
+	}
+	for (unsigned i = 0; i < shnum; i++) {
+		if (getsect(i, &s) != 0) {
+			break;
+		}
+		if (names.off + s.name + sizeof(".klfmt")
+			<= (unsigned long long)elflen
+		    && memcmp(elf + names.off + s.name, ".klfmt",
+			      sizeof(".klfmt")) == 0) {
+			return s.addr;
+		}
+	}
+	return 0;
+}
+
+/* Return the string at a flash address, or NULL if no loaded	*/
+/*   section holds it						*/
+
+static const char *flashstr(unsigned fmt)
+{
+	unsigned	shnum = get16(elf + (elf64 ? 60 : 48));
+	unsigned long long	addr = fmt;
+	struct sect	s;
+
+	if (elf64) {
+		if ((addr = klfmtaddr()) == 0) {
+			return NULL;
+		}
+		addr = (addr & ~0xffffULL) | fmt;
+	}
+	for (unsigned i = 0; i < shnum; i++) {
+		if (getsect(i, &s) != 0) {
+			break;
+		}
+		if (s.type != SHT_PROGBITS || !(s.flags & SHF_ALLOC)
+		    || addr < s.addr || addr >= s.addr + s.size
+		    || s.off + s.size > (unsigned long long)elflen) {
+			continue;
+		}
+		if (memchr(elf + s.off + addr - s.addr, '\0',
+			   s.addr + s.size - addr) == NULL) {
+			return NULL;
+		}
+		return (const char *)elf + s.off + addr - s.addr;
+	}
+	return NULL;
+}
+
+/* Print a format with the arguments of one record; the sizes	*/
+/*   follow the same rules as klognext() in system/klog.c	*/
+
+static void format(const char *fmt, const unsigned char *a, int len)
+{
+	char	spec[32];
+	const char	*s;
+	int	n, size;
+	unsigned long	v;
+
+	while (*fmt != '\0') {
+		if (*fmt != '%') {
+			putchar(*fmt++);
+			continue;
+		}
+		s = fmt++;
+		fmt += strspn(fmt, "-+ #0123456789.");
+		if (*fmt == '\0') {
+			fputs(s, stdout);
+			break;
+		}
+		if (*fmt == '%') {
+			putchar('%');
+			fmt++;
+			continue;
+		}
+		size = 2;
+		if (*fmt == 'l') {
+			size = 4;
+			fmt++;
+		}
+		if (*fmt == '\0' || size > len) {
+			printf("<?>");
+			return;
+		}
+		n = fmt - s;
+		if (n > (int)sizeof(spec) - 3) {
+			n = sizeof(spec) - 3;
+		}
+		memcpy(spec, s, n);
+		v = (size == 4) ? get32(a) : get16(a);
+		a += size;
+		len -= size;
+		switch (*fmt) {
+		case 'd':
+		case 'i':
+			strcpy(spec + n, "ld");
+			printf(spec, size == 4 ? (long)(int)v : (long)(short)v);
+			break;
+		case 'c':
+			strcpy(spec + n, "c");
+			printf(spec, (int)(v & 0xff));
+			break;
+		case 'u':
+		case 'x':
+		case 'X':
+		case 'o':
+			spec[n] = 'l';
+			spec[n + 1] = *fmt;
+			spec[n + 2] = '\0';
+			printf(spec, v);
+			break;
+		default:
+			printf("<%%%c?>", *fmt);
+			break;
+		}
+		fmt++;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	FILE	*in;
+	unsigned char	b[KLHDR + 255];
+	unsigned long long	ticks = 0;	/* Unwrapped clkticks	*/
+	long	lasttick = -1;
+	unsigned	fmt, tick;
+	const char	*s;
+	int	c, len, skipped = 0, bad = 0;
+
+	if (argc != 3) {
+		fprintf(stderr, "usage: klogdec xinu.elf capture.bin\n");
+		return 1;
+	}
+	if (loadelf(argv[1]) != 0) {
+		return 1;
+	}
+	if ((in = fopen(argv[2], "rb")) == NULL) {
+		perror(argv[2]);
+		return 1;
+	}
+
+	/* Skip to KLSYNC, read the header and then the arguments; a	*/
+	/*   format address outside flash means the sync was false	*/
+
+	while ((c = getc(in)) != EOF) {
+		if (c != KLSYNC) {
+			skipped++;
+			continue;
+		}
+		if (fread(b + 1, 1, KLHDR - 1, in) != KLHDR - 1) {
+			break;
+		}
+		fmt = get16(b + 1);
+		tick = get16(b + 3);
+		len = b[5];
+		s = (fmt == 0) ? "" : flashstr(fmt);
+		if (s == NULL || (fmt == 0 && len != 1)) {
+			bad++;
+			fseek(in, -(KLHDR - 1), SEEK_CUR);
+			continue;
+		}
+		if (fread(b + KLHDR, 1, len, in) != (size_t)len) {
+			break;
+		}
+		if (lasttick >= 0 && tick < lasttick) {
+			ticks += 65536;
+		}
+		lasttick = tick;
+		printf("[%10.3f] ", (ticks + tick) / 1000.0);
+		if (fmt == 0) {
+			printf("[lost %u]\n", b[KLHDR]);
+			continue;
+		}
+		format(s, b + KLHDR, len);
+		if (s[0] == '\0' || s[strlen(s) - 1] != '\n') {
+			putchar('\n');
+		}
+	}
+	fclose(in);
+
+	if (skipped + bad > 0) {
+		fprintf(stderr, "klogdec: skipped %d bytes, %d false syncs\n",
+			skipped, bad);
+	}
+	return 0;
+}
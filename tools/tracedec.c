@@ -0,0 +1,216 @@
+/* tracedec.c - decode a Xinu-AVR kernel trace capture (host tool)
+ *
+ * Reads the byte stream sent by the null process when the kernel is
+ * built with TRACE set (see include/trace.h) and writes a timeline in
+ * Chrome trace JSON (chrome://tracing, Perfetto) or VCD (GTKWave).
+ *
+ *	cc -O2 -o tracedec tracedec.c
+ *	cat /dev/ttyUSB0 > capture.bin
+ *	tracedec capture.bin > trace.json
+ *	tracedec -v capture.bin > trace.vcd
+ *
+ * Timestamps are rebuilt from the low byte of clkticks and TCNT2, so
+ * the capture must contain an event at least every 256 ms; the clock
+ * ISR events, recorded every TRACECLK (at most 128) ms, take care of
+ * that.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define	TRSYNC		0x7e	/* Must match include/trace.h		*/
+#define	TR_CTXSW	1
+#define	TR_WAIT		2
+#define	TR_SIGNAL	3
+#define	TR_ISRIN	4
+#define	TR_ISROUT	5
+#define	TR_SLEEP	6
+#define	TR_WAKEUP	7
+#define	TR_LOST		8
+
+#define	USPERTICK	1000	/* TIMER2 tick				*/
+#define	USPERCNT	8	/* TCNT2 count at the 1 ms tick		*/
+#define	ISRTID		100	/* Chrome thread used for interrupts	*/
+
+struct event {
+	int	type;
+	int	arg;
+	unsigned long long us;	/* Rebuilt timestamp			*/
+};
+
+static int	vcd;		/* Nonzero for VCD output		*/
+static int	first = 1;	/* No JSON record written yet		*/
+static int	running = -1;	/* Process currently on the CPU		*/
+static int	inisr = -1;	/* Interrupt being handled, or -1	*/
+
+static void json(const char *fmt, unsigned long long us, int tid,
+		 const char *name, int arg)
+{
+	printf("%s\n{\"ph\":\"%s\",\"ts\":%llu,\"pid\":0,\"tid\":%d,"
+	       "\"name\":\"%s\"", first ? "" : ",", fmt, us, tid, name);
+	if (arg >= 0) {
+		printf(",\"args\":{\"arg\":%d}", arg);
+	}
+	if (fmt[0] == 'i') {
+		printf(",\"s\":\"t\"");
+	}
+	printf("}");
+	first = 0;
+}
+
+static void emit(const struct event *e)
+{
+	static char	name[16];	/* Label of the running slice	*/
+	int	from, to;
+
+	switch (e->type) {
+	case TR_CTXSW:
+		from = e->arg >> 4;
+		to = e->arg & 0xf;
+		if (inisr >= 0) {	/* Handler switched processes	*/
+			if (vcd) {
+				printf("#%llu\n0i\n", e->us);
+			} else {
+				json("E", e->us, ISRTID, "isr", -1);
+			}
+			inisr = -1;
+		}
+		if (vcd) {
+			printf("#%llu\n", e->us);
+			for (int i = 7; i >= 0; i--) {
+				putchar('0' + ((to >> i) & 1));
+			}
+			printf(" p\n");
+		} else {
+			if (running >= 0) {
+				json("E", e->us, running, name, -1);
+			}
+			snprintf(name, sizeof(name), "pid %d", to);
+			json("B", e->us, to, name, from);
+		}
+		running = to;
+		break;
+
+	case TR_ISRIN:
+		inisr = e->arg;
+		if (vcd) {
+			printf("#%llu\n1i\n", e->us);
+		} else {
+			json("B", e->us, ISRTID, "isr", e->arg);
+		}
+		break;
+
+	case TR_ISROUT:
+		if (inisr < 0) {	/* Already closed at a switch	*/
+			break;
+		}
+		inisr = -1;
+		if (vcd) {
+			printf("#%llu\n0i\n", e->us);
+		} else {
+			json("E", e->us, ISRTID, "isr", -1);
+		}
+		break;
+
+	case TR_WAIT:
+	case TR_SIGNAL:
+		if (vcd) {
+			printf("#%llu\n", e->us);
+			for (int i = 7; i >= 0; i--) {
+				putchar('0' + ((e->arg >> i) & 1));
+			}
+			printf(" %c\n", e->type == TR_WAIT ? 'w' : 's');
+		} else {
+			json("i", e->us, running < 0 ? 0 : running,
+			     e->type == TR_WAIT ? "wait" : "signal", e->arg);
+		}
+		break;
+
+	case TR_SLEEP:
+	case TR_WAKEUP:
+	case TR_LOST:
+		if (!vcd) {
+			json("i", e->us, e->type == TR_LOST ? ISRTID : e->arg,
+			     e->type == TR_SLEEP ? "sleep" :
+			     e->type == TR_WAKEUP ? "wakeup" : "lost", e->arg);
+		}
+		break;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	FILE	*in;
+	unsigned char	b[5];
+	unsigned long long	ticks = 0;	/* Unwrapped clkticks	*/
+	int	lasttick = -1;
+	int	c, n = 0, skipped = 0;
+	struct event	e;
+
+	if (argc > 1 && strcmp(argv[1], "-v") == 0) {
+		vcd = 1;
+		argc--;
+		argv++;
+	}
+	if (argc != 2) {
+		fprintf(stderr, "usage: tracedec [-v] capture.bin\n");
+		return 1;
+	}
+	if ((in = fopen(argv[1], "rb")) == NULL) {
+		perror(argv[1]);
+		return 1;
+	}
+
+	if (vcd) {
+		printf("$timescale 1us $end\n$scope module xinu $end\n"
+		       "$var wire 8 p running $end\n"
+		       "$var wire 1 i isr $end\n"
+		       "$var wire 8 w wait $end\n"
+		       "$var wire 8 s signal $end\n"
+		       "$upscope $end\n$enddefinitions $end\n");
+	} else {
+		printf("[");
+	}
+
+	/* Events are five bytes starting with TRSYNC; resynchronize	*/
+	/*   byte by byte if the capture started mid-event		*/
+
+	while ((c = getc(in)) != EOF) {
+		b[n++] = c;
+		if (b[0] != TRSYNC) {
+			n = 0;
+			skipped++;
+			continue;
+		}
+		if (n < 5) {
+			continue;
+		}
+		n = 0;
+		if (b[1] < TR_CTXSW || b[1] > TR_LOST) {
+			n = 5;			/* Not an event: slide	*/
+			do {
+				memmove(b, b + 1, --n);
+				skipped++;
+			} while (n > 0 && b[0] != TRSYNC);
+			continue;
+		}
+		if (lasttick >= 0 && b[3] < lasttick) {
+			ticks += 256;
+		}
+		lasttick = b[3];
+		e.type = b[1];
+		e.arg = b[2];
+		e.us = (ticks + b[3]) * USPERTICK + b[4] * USPERCNT;
+		emit(&e);
+	}
+	fclose(in);
+
+	if (!vcd) {
+		printf("\n]\n");
+	}
+	if (skipped > 0) {
+		fprintf(stderr, "tracedec: skipped %d bytes\n", skipped);
+	}
+	return 0;
+}
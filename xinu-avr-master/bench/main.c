@@ -0,0 +1,880 @@
+/* main.c - main, bwake, bnotify, bnop, baudio, byield, bcoping, bcopong,
+ *	      bdwfunc, cycles, brdylist, bchurn, birq, baudiorun (kernel
+ *	      benchmark)
+ *
+ * Application linked instead of main/ by 'make bench' (see
+ * compile/Makefile) and run under simavr.  Each kernel call is timed
+ * NRUNS times in CPU cycles with Timer1 running at clk/1, and one line
+ * per call is printed on the UART:
+ *
+ *	BENCH name min avg max n
+ *
+ * The Makefile keeps those lines in compile/bench.txt.  The cost of
+ * reading the cycle counter is measured first and subtracted.  The
+ * ready list lines carry the number of ready processes in their name
+ * (rdyins4 ...); building once with RDYBITMAP 0 and once with 1
+ * compares the two lists.  cororam, procram and procstk are bytes, not
+ * cycles: what a coroutine and a process doing the same yield loop
+ * take.  The churn lines time getmem/freemem of mixed sizes freed in
+ * random order (build with NMPOOL 0 and with pools to compare); after
+ * them heapfree and heaplargest are bytes, and mpreport() prints the
+ * pools.  irq2dwork (DWORK 1 only) runs from the same compare match
+ * as irq2task to the start of a deferred work function.  The audio
+ * lines come last: they time an
+ * interrupt handler like the slave's 5.5 kHz audio one while the
+ * kernel is busy, and audiomiss counts the samples it missed.
+ */
+
+#include <xinu.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+#define	NRUNS		32	/* Samples per measurement		*/
+#define	BSTK		128	/* Stack of the helper processes	*/
+#define	BHIPRIO		30	/* bwake: above main (INITPRIO)		*/
+#define	BLOPRIO		10	/* bnop: below main, never runs		*/
+#define	BFILLPRIO	15	/* brdylist: above null, below main	*/
+#define	IRQDELAY	2000	/* Cycles from arming to compare match	*/
+#define	BNOTE		0x01	/* Notification bit for bnotify		*/
+#define	CHSLOTS		10	/* Blocks bchurn keeps at most		*/
+#define	CHROUNDS	400	/* Allocations or releases in bchurn	*/
+#define	APERIOD		2902	/* Cycles per audio sample: the slave's	*/
+				/*   OCR1A 0x0B55 in CTC mode, 5.5 kHz	*/
+#define	ASAMPLES	2000	/* Samples played by baudiorun		*/
+#define	AHALF		200	/* Samples per half buffer (slave's	*/
+				/*   HALF_BUFFER): baudio is notified	*/
+
+struct	bstat	{		/* Statistics of one measurement	*/
+	uint32	bmin;
+	uint32	bmax;
+	uint32	bsum;
+	uint16	bn;
+};
+
+local	uint16	ovh;		/* Cycles taken by cycles() itself	*/
+
+/* Request sizes bchurn mixes: the pool classes and sizes between them */
+
+local	const __flash uint16	chsizes[] = { 8, 12, 16, 24, 32, 40 };
+#define	NCHSIZES	(sizeof(chsizes) / sizeof(chsizes[0]))
+
+/* Ready list lengths measured, counting the null process; the last is	*/
+/*   every process but main.  Lengths the free slots do not allow or	*/
+/*   not above the one before are skipped, so with NPROC 5 only 2 and	*/
+/*   4 are printed						*/
+
+local	const __flash int16	rdylens[] = { 2, 4, NPROC - 1 };
+#define	NRDYLENS	(sizeof(rdylens) / sizeof(rdylens[0]))
+
+volatile uint16	t1hi;		/* Timer1 overflows (cycles >> 16)	*/
+volatile uint32	twake;		/* Cycle at which bwake ran		*/
+sid32	semwake;		/* Released to run bwake		*/
+sid32	semdone;		/* Signalled by bwake after each run	*/
+
+pid32	audiopid;		/* ID of baudio				*/
+volatile uint16	asamples;	/* Samples played so far		*/
+volatile uint16	amissed;	/* Samples whose match had passed by	*/
+				/*   the time the handler got to it	*/
+volatile uint32	amatch;		/* Cycle of the match that notified	*/
+struct	bstat	salat;		/* Match to handler entry		*/
+struct	bstat	saisr;		/* Handler entry to isr_exit		*/
+struct	bstat	sawake;		/* Match to baudio running		*/
+
+#if DWORK
+local	void	bdwfunc(void *);
+struct	dwork	bdwork = DWORK_INIT(bdwfunc, NULL); /* Posted by the	*/
+volatile bool8	bdwirq;		/*   compare B handler while bdwirq	*/
+#endif
+
+struct	cosched	cosched;	/* Set run by the coroutine round trip	*/
+struct	coro	coping, copong;	/* Its two coroutines			*/
+int16	coturns;		/* Round trips made by coping		*/
+uint32	cot0;			/* cycles() when coping yielded		*/
+struct	bstat	scoro;		/* Coroutine round trips		*/
+volatile bool8	ydone;		/* Tells byield to finish		*/
+
+/*------------------------------------------------------------------------
+ *  Timer1 interrupts: overflow extends the counter to 32 bits, compare
+ *  B is the event whose latency to a waiting process is measured
+ *------------------------------------------------------------------------
+ */
+ISR(TIMER1_OVF_vect)
+{
+	t1hi++;
+}
+
+ISR(TIMER1_COMPB_vect)
+{
+#if DWORK
+	if (bdwirq) {
+		dwpost_isr(&bdwork);
+		isr_exit();
+		return;
+	}
+#endif
+	signal_isr(semwake);
+	isr_exit();
+}
+
+/*------------------------------------------------------------------------
+ *  cycles  -  Return the number of CPU cycles since Timer1 was started
+ *------------------------------------------------------------------------
+ */
+uint32	cycles(void)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	uint16	lo, hi;
+
+	mask = disable();
+	lo = TCNT1;
+	hi = t1hi;
+	if ((TIFR1 & (1 << TOV1)) && lo < 0x8000) {
+		hi++;			/* Overflow not yet counted	*/
+	}
+	restore(mask);
+	return ((uint32)hi << 16) | lo;
+}
+
+/*------------------------------------------------------------------------
+ *  bclear, bsample, badd, breport  -  Collect and print one measurement;
+ *  badd takes a time from cycles() and subtracts what reading it cost
+ *------------------------------------------------------------------------
+ */
+local	void	bclear(
+	  struct bstat	*sp		/* Measurement to reset		*/
+	)
+{
+	sp->bmin = 0xffffffffUL;
+	sp->bmax = 0;
+	sp->bsum = 0;
+	sp->bn = 0;
+}
+
+local	void	bsample(
+	  struct bstat	*sp,		/* Measurement to update	*/
+	  uint32	c		/* Value to add			*/
+	)
+{
+	if (c < sp->bmin) {
+		sp->bmin = c;
+	}
+	if (c > sp->bmax) {
+		sp->bmax = c;
+	}
+	sp->bsum += c;
+	sp->bn++;
+}
+
+local	void	badd(
+	  struct bstat	*sp,		/* Measurement to update	*/
+	  uint32	c		/* Cycles measured		*/
+	)
+{
+	bsample(sp, (c > ovh) ? c - ovh : 0);
+}
+
+local	void	breport(
+	  char		*name,		/* Name of the measurement	*/
+	  struct bstat	*sp		/* Its samples			*/
+	)
+{
+	kprintf("BENCH %s %lu %lu %lu %u\n", name, sp->bmin,
+		sp->bsum / sp->bn, sp->bmax, sp->bn);
+}
+
+local	void	breportn(
+	  char		*name,		/* Name of the measurement	*/
+	  int16		n,		/* Appended to the name		*/
+	  struct bstat	*sp		/* Its samples			*/
+	)
+{
+	kprintf("BENCH %s%d %lu %lu %lu %u\n", name, n, sp->bmin,
+		sp->bsum / sp->bn, sp->bmax, sp->bn);
+}
+
+/*------------------------------------------------------------------------
+ *  Timer1 compare A: the audio handler of the slave with the DAC write
+ *  left out; one sample every APERIOD cycles, a notification to baudio
+ *  every AHALF.  Its own times go straight into salat and saisr
+ *------------------------------------------------------------------------
+ */
+ISR(TIMER1_COMPA_vect)
+{
+	uint16	match;			/* TCNT1 of this compare match	*/
+	uint16	late;			/* Cycles from match to here	*/
+
+	match = OCR1A;
+	late = TCNT1 - match;
+	if (late >= APERIOD) {		/* The next match has passed:	*/
+		amissed++;		/*   start again from now	*/
+		OCR1A = TCNT1 + APERIOD;
+	} else {
+		OCR1A = match + APERIOD;
+	}
+	if (++asamples >= ASAMPLES) {
+		TIMSK1 &= ~(1 << OCIE1A);
+	}
+	bsample(&salat, late);
+	if (asamples % AHALF == 0) {
+		amatch = cycles() - (uint16)(TCNT1 - match);
+		notify_isr(audiopid, BNOTE);
+	}
+	bsample(&saisr, (uint16)(TCNT1 - match) - late);
+	isr_exit();
+}
+
+/*------------------------------------------------------------------------
+ *  bwake  -  High priority process: note when it runs after semwake is
+ *	      signalled, by a process or by the Timer1 compare interrupt
+ *------------------------------------------------------------------------
+ */
+process	bwake(void)
+{
+	while (TRUE) {
+		wait(semwake);
+		twake = cycles();
+		signal(semdone);
+	}
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  bnotify  -  Same as bwake, released by a notification instead of a
+ *		semaphore
+ *------------------------------------------------------------------------
+ */
+process	bnotify(void)
+{
+	while (TRUE) {
+		notifywait(BNOTE, NOTIFYFOREVER);
+		twake = cycles();
+		signal(semdone);
+	}
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  baudio  -  Stands for the slave's SD task: note how long after the
+ *	       compare match that notified it it runs
+ *------------------------------------------------------------------------
+ */
+process	baudio(void)
+{
+	while (TRUE) {
+		notifywait(BNOTE, NOTIFYFOREVER);
+		badd(&sawake, cycles() - amatch);
+	}
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  byield  -  Process at main's priority that hands the CPU back to main
+ *	       each time main yields to it
+ *------------------------------------------------------------------------
+ */
+process	byield(void)
+{
+	while (!ydone) {
+		yield();
+	}
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  bcoping, bcopong  -  The same handoff between two coroutines of one
+ *			 process; coping times each round trip (globals,
+ *			 as locals do not survive CO_YIELD)
+ *------------------------------------------------------------------------
+ */
+char	bcoping(
+	  struct coro	*co		/* This coroutine		*/
+	)
+{
+	CO_BEGIN(co);
+	for (coturns = 0; coturns < NRUNS; coturns++) {
+		cot0 = cycles();
+		CO_YIELD(co);
+		badd(&scoro, cycles() - cot0);
+	}
+	CO_END(co);
+}
+
+char	bcopong(
+	  struct coro	*co		/* This coroutine		*/
+	)
+{
+	CO_BEGIN(co);
+	while (coturns < NRUNS) {
+		CO_YIELD(co);
+	}
+	CO_END(co);
+}
+
+#if DWORK
+/*------------------------------------------------------------------------
+ *  bdwfunc  -  Deferred work posted by the compare B handler: note when
+ *		the work daemon started it, as bwake does
+ *------------------------------------------------------------------------
+ */
+local	void	bdwfunc(
+	  void		*arg		/* Unused			*/
+	)
+{
+	twake = cycles();
+	signal(semdone);
+}
+#endif
+
+/*------------------------------------------------------------------------
+ *  bnop  -  Process created and killed by the benchmark; never runs
+ *------------------------------------------------------------------------
+ */
+process	bnop(void)
+{
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  brdylist  -  Time the ready list with 2, 4 and NPROC-1 processes on
+ *		 it: insert and dequeue on their own, then the resched
+ *		 that runs bwake.  Called with bwake created but still
+ *		 suspended and every other slot but main's free
+ *------------------------------------------------------------------------
+ */
+local	void	brdylist(
+	  pid32		wakepid		/* ID of bwake			*/
+	)
+{
+	struct	bstat	s1, s2;		/* Results being collected	*/
+	pid32	fill[NPROC];		/* Suspended processes whose	*/
+	int16	nfill;			/*   IDs are put on the list	*/
+	int16	nready;			/* Fillers resumed so far	*/
+	int16	len, prev;		/* Ready list length measured	*/
+	int16	maxlen;			/* Longest the slots allow	*/
+	intmask	mask;			/* Saved interrupt mask		*/
+	uint32	t0, t1;
+	pid32	pid;
+	int16	i, j, k;
+
+	for (nfill = 0; nfill < NPROC - 3; nfill++) {
+		fill[nfill] = create(bnop, BSTK, BFILLPRIO, "bfill", 0);
+		if (fill[nfill] == SYSERR) {
+			break;		/* Slots taken by daemons	*/
+		}
+	}
+	fill[nfill++] = wakepid;
+	maxlen = nfill + 1;
+
+	/* Insert and dequeue alone.  The null process and len-2	*/
+	/*   fillers are on the list; the last filler goes in at the	*/
+	/*   same priority, behind the others as for round robin (the	*/
+	/*   longest walk of the key-ordered list), then the first	*/
+	/*   process is taken off.  None of them runs: the list is put	*/
+	/*   back with interrupts still disabled			*/
+
+	prev = 1;
+	for (k = 0; k < NRDYLENS; k++) {
+		len = rdylens[k];
+		if (len > maxlen || len <= prev) {
+			continue;
+		}
+		prev = len;
+		bclear(&s1);
+		bclear(&s2);
+		for (i = 0; i < NRUNS; i++) {
+			mask = disable();
+			for (j = 0; j < len - 2; j++) {
+				rdyinsert(fill[j], BFILLPRIO);
+			}
+			t0 = cycles();
+			rdyinsert(fill[j], BFILLPRIO);
+			t1 = cycles();
+			badd(&s1, t1 - t0);
+			t0 = cycles();
+			pid = rdydequeue();
+			t1 = cycles();
+			badd(&s2, t1 - t0);
+			for (j = 0; j < len - 1; j++) {
+				if (fill[j] != pid) {
+					rdyremove(fill[j]);
+				}
+			}
+			restore(mask);
+		}
+		breportn("rdyins", len, &s1);
+		breportn("rdydeq", len, &s2);
+	}
+
+	/* resched with the list that long: signal readies bwake next	*/
+	/*   to the null process and len-2 fillers, now really resumed	*/
+	/*   and below main, so that they never run			*/
+
+	resume(wakepid);
+	nfill--;
+	nready = 0;
+	prev = 1;
+	for (k = 0; k < NRDYLENS; k++) {
+		len = rdylens[k];
+		if (len > maxlen || len <= prev) {
+			continue;
+		}
+		prev = len;
+		while (nready < len - 2) {
+			resume(fill[nready++]);
+		}
+		bclear(&s1);
+		for (i = 0; i < NRUNS; i++) {
+			t0 = cycles();
+			signal(semwake);
+			badd(&s1, twake - t0);
+			wait(semdone);
+		}
+		breportn("rdysched", len, &s1);
+	}
+	for (i = 0; i < nfill; i++) {
+		kill(fill[i]);
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  brand  -  Return the next number of a 16-bit xorshift sequence; the
+ *	      seed is fixed so that runs can be compared
+ *------------------------------------------------------------------------
+ */
+local	uint16	brand(void)
+{
+	static	uint16	x = 0xace1;	/* Last value returned		*/
+
+	x ^= x << 7;
+	x ^= x >> 9;
+	x ^= x << 8;
+	return x;
+}
+
+/*------------------------------------------------------------------------
+ *  bchurn  -  Allocate and free blocks of mixed sizes in random order,
+ *	       CHROUNDS times, timing each call; then report the heap as
+ *	       the churn left it and give everything back
+ *------------------------------------------------------------------------
+ */
+local	void	bchurn(void)
+{
+	struct	bstat	s1, s2;		/* getmem and freemem times	*/
+	struct	bstat	s3;		/* Requests that failed		*/
+	char	*blks[CHSLOTS];		/* Live blocks (NULL = none)	*/
+	uint16	lens[CHSLOTS];		/* Their sizes			*/
+	struct	memblk	*memptr;	/* Walks the heap free list	*/
+	uint32	before;			/* Free heap before the churn	*/
+	uint32	largest;		/* Largest free heap block	*/
+	uint32	t0, t1;
+	intmask	mask;			/* Saved interrupt mask		*/
+	uint16	nfail;
+	int16	i, k;
+
+	for (k = 0; k < CHSLOTS; k++) {
+		blks[k] = NULL;
+	}
+	before = memlist.mlength;
+	nfail = 0;
+	bclear(&s1);
+	bclear(&s2);
+	for (i = 0; i < CHROUNDS; i++) {
+		k = brand() % CHSLOTS;
+		if (blks[k] != NULL) {
+			t0 = cycles();
+			freemem(blks[k], lens[k]);
+			t1 = cycles();
+			badd(&s2, t1 - t0);
+			blks[k] = NULL;
+			continue;
+		}
+		lens[k] = chsizes[brand() % NCHSIZES];
+		t0 = cycles();
+		blks[k] = getmem(lens[k]);
+		t1 = cycles();
+		badd(&s1, t1 - t0);
+		if (blks[k] == (char *)SYSERR) {
+			blks[k] = NULL;
+			nfail++;
+		}
+	}
+	breport("churnget", &s1);
+	breport("churnfree", &s2);
+	bclear(&s3);
+	bsample(&s3, nfail);
+	breport("churnfail", &s3);
+
+	/* The heap with the surviving blocks still allocated: free	*/
+	/*   bytes and the largest block (see mpreport)			*/
+
+	mask = disable();
+	largest = 0;
+	for (memptr = memlist.mnext; memptr != NULL; memptr = memptr->mnext) {
+		if (memptr->mlength > largest) {
+			largest = memptr->mlength;
+		}
+	}
+	restore(mask);
+	bclear(&s1);
+	bsample(&s1, memlist.mlength);
+	breport("heapfree", &s1);
+	bclear(&s1);
+	bsample(&s1, largest);
+	breport("heaplargest", &s1);
+#if NMPOOL > 0
+	mpreport();
+#endif
+
+	for (k = 0; k < CHSLOTS; k++) {
+		if (blks[k] != NULL) {
+			freemem(blks[k], lens[k]);
+		}
+	}
+	if (memlist.mlength != before) {
+		panic("bench churn leaked heap");
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  birq  -  Arm Timer1 compare B IRQDELAY cycles ahead NRUNS times and
+ *	     time each match to the moment its handler's work ran (twake),
+ *	     while main waits and the null process is current
+ *------------------------------------------------------------------------
+ */
+local	void	birq(
+	  struct bstat	*sp		/* Measurement to fill		*/
+	)
+{
+	uint32	t0;
+	int16	i;
+
+	bclear(sp);
+	for (i = 0; i < NRUNS; i++) {
+		disable();
+		t0 = cycles() + IRQDELAY;
+		OCR1B = (uint16)t0;
+		TIFR1 = (1 << OCF1B);
+		TIMSK1 |= (1 << OCIE1B);
+		enable();
+		wait(semdone);
+		TIMSK1 &= ~(1 << OCIE1B);
+		badd(sp, twake - t0);
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  baudiorun  -  Play ASAMPLES audio samples from Timer1 compare A while
+ *		  main keeps making kernel calls, each of which disables
+ *		  interrupts for part of its run, and report the
+ *		  handler's times
+ *------------------------------------------------------------------------
+ */
+local	void	baudiorun(void)
+{
+	struct	bstat	s1;		/* Samples missed		*/
+	char	*blk;
+	int16	i;
+
+	audiopid = create(baudio, BSTK, BHIPRIO, "baudio", 0);
+	if (audiopid == SYSERR) {
+		panic("bench audio create");
+	}
+	resume(audiopid);
+	bclear(&salat);
+	bclear(&saisr);
+	bclear(&sawake);
+	asamples = 0;
+	amissed = 0;
+
+	disable();
+	OCR1A = TCNT1 + APERIOD;
+	TIFR1 = (1 << OCF1A);
+	TIMSK1 |= (1 << OCIE1A);
+	enable();
+
+	for (i = 0; asamples < ASAMPLES; i++) {
+		blk = getmem(16);
+		freemem(blk, 16);
+		send(getpid(), i);
+		receive();
+		signal(semdone);
+		wait(semdone);
+		if (i % 16 == 0) {
+			sleepms(1);
+		}
+	}
+	kill(audiopid);
+
+	bclear(&s1);
+	bsample(&s1, amissed);
+	breport("audiolat", &salat);
+	breport("audioisr", &saisr);
+	breport("audiowake", &sawake);
+	breport("audiomiss", &s1);
+}
+
+/*------------------------------------------------------------------------
+ *  main  -  Time each kernel call, print the results and stop simavr
+ *------------------------------------------------------------------------
+ */
+void	main(void)
+{
+	struct	bstat	s1, s2;		/* Results being collected	*/
+	uint32	t0, t1;
+	pid32	pid;
+	pid32	wakepid;		/* ID of bwake			*/
+	pid32	notifypid;		/* ID of bnotify		*/
+	char	*blk;
+	int16	i;
+
+	/* Timer1 counts CPU cycles; the clock keeps Timer2 */
+
+	TCCR1A = 0;
+	TCCR1B = (1 << CS10);
+	TIMSK1 = (1 << TOIE1);
+
+	semwake = semcreate(0);
+	semdone = semcreate(0);
+	wakepid = create(bwake, BSTK, BHIPRIO, "bwake", 0);
+	kprintf("BENCH # name min avg max n (cycles)\n");
+
+	/* Cost of the measurement itself */
+
+	ovh = 0xffff;
+	for (i = 0; i < NRUNS; i++) {
+		t0 = cycles();
+		t1 = cycles();
+		if (t1 - t0 < ovh) {
+			ovh = t1 - t0;
+		}
+	}
+
+	/* Ready list, while the other slots are free; it resumes bwake	*/
+
+	brdylist(wakepid);
+	notifypid = create(bnotify, BSTK, BHIPRIO, "bnotify", 0);
+	resume(notifypid);
+
+	/* create, resume (lower priority: no switch) and kill */
+
+	bclear(&s1);
+	bclear(&s2);
+	for (i = 0; i < NRUNS; i++) {
+		t0 = cycles();
+		pid = create(bnop, BSTK, BLOPRIO, "bnop", 0);
+		t1 = cycles();
+		if (pid == SYSERR) {
+			panic("bench create");
+		}
+		badd(&s1, t1 - t0);
+		t0 = cycles();
+		resume(pid);
+		t1 = cycles();
+		badd(&s2, t1 - t0);
+		kill(pid);
+	}
+	breport("create", &s1);
+	breport("resume", &s2);
+
+	/* signal with no waiter, then wait that does not block */
+
+	bclear(&s1);
+	bclear(&s2);
+	for (i = 0; i < NRUNS; i++) {
+		t0 = cycles();
+		signal(semdone);
+		t1 = cycles();
+		badd(&s1, t1 - t0);
+	}
+	for (i = 0; i < NRUNS; i++) {
+		t0 = cycles();
+		wait(semdone);
+		t1 = cycles();
+		badd(&s2, t1 - t0);
+	}
+	breport("signal", &s1);
+	breport("wait", &s2);
+
+	/* signal that readies a higher priority process: from the call	*/
+	/*   to the moment bwake runs, i.e. one resched and ctxsw	*/
+
+	bclear(&s1);
+	for (i = 0; i < NRUNS; i++) {
+		t0 = cycles();
+		signal(semwake);
+		badd(&s1, twake - t0);
+		wait(semdone);
+	}
+	breport("resched", &s1);
+
+	/* The same handoff with notify/notifywait in place of		*/
+	/*   signal/wait						*/
+
+	bclear(&s1);
+	for (i = 0; i < NRUNS; i++) {
+		t0 = cycles();
+		notify(notifypid, BNOTE);
+		badd(&s1, twake - t0);
+		wait(semdone);
+	}
+	breport("notifywake", &s1);
+
+	/* Two coroutines yielding to each other, then main and a	*/
+	/*   process of its priority: each round trip is two switches.	*/
+	/*   Then the RAM each takes: a struct coro, against a process	*/
+	/*   table entry, its queue entry and the stack it was given,	*/
+	/*   of which procstk were ever used				*/
+
+	bclear(&scoro);
+	costart(&cosched, &copong, bcopong);
+	costart(&cosched, &coping, bcoping);	/* Runs first		*/
+	corun(&cosched);
+	breport("coyield", &scoro);
+
+	ydone = FALSE;
+	pid = create(byield, BSTK, INITPRIO, "byield", 0);
+	if (pid == SYSERR) {
+		panic("bench byield create");
+	}
+	resume(pid);
+	bclear(&s1);
+	for (i = 0; i < NRUNS; i++) {
+		t0 = cycles();
+		yield();
+		t1 = cycles();
+		badd(&s1, t1 - t0);
+	}
+	breport("procyield", &s1);
+
+	bclear(&s1);
+	bsample(&s1, sizeof(struct coro));
+	breport("cororam", &s1);
+	bclear(&s1);
+	bsample(&s1, sizeof(struct procent) + sizeof(struct qentry)
+		+ proctab[pid].prstklen);
+	breport("procram", &s1);
+	bclear(&s1);
+	bsample(&s1, stkusage(pid));
+	breport("procstk", &s1);
+	ydone = TRUE;
+	yield();			/* byield returns and exits	*/
+
+	/* getmem and freemem of a small block */
+
+	bclear(&s1);
+	bclear(&s2);
+	for (i = 0; i < NRUNS; i++) {
+		t0 = cycles();
+		blk = getmem(16);
+		t1 = cycles();
+		badd(&s1, t1 - t0);
+		t0 = cycles();
+		freemem(blk, 16);
+		t1 = cycles();
+		badd(&s2, t1 - t0);
+	}
+	breport("getmem", &s1);
+	breport("freemem", &s2);
+
+#if NMPOOL > 0
+	/* Pool blocks: mpget/mpfree directly, then freemem of a block	*/
+	/*   from getmem(16) (served by the pool) and of an address	*/
+	/*   inside one, which must be refused without a heap walk	*/
+
+	bclear(&s1);
+	bclear(&s2);
+	for (i = 0; i < NRUNS; i++) {
+		t0 = cycles();
+		blk = mpget(16);
+		t1 = cycles();
+		badd(&s1, t1 - t0);
+		t0 = cycles();
+		mpfree(blk);
+		t1 = cycles();
+		badd(&s2, t1 - t0);
+	}
+	breport("mpget", &s1);
+	breport("mpfree", &s2);
+
+	bclear(&s1);
+	bclear(&s2);
+	for (i = 0; i < NRUNS; i++) {
+		blk = getmem(16);
+		t0 = cycles();
+		if (freemem(blk + 2, 16) != SYSERR) {
+			panic("bench freemem inside a pool block");
+		}
+		t1 = cycles();
+		badd(&s2, t1 - t0);
+		t0 = cycles();
+		freemem(blk, 16);
+		t1 = cycles();
+		badd(&s1, t1 - t0);
+	}
+	breport("freemempool", &s1);
+	breport("freemembad", &s2);
+#endif
+
+	/* Allocation under churn, pools or not (see bchurn)		*/
+
+	bchurn();
+
+	/* send to itself, then receive the message */
+
+	bclear(&s1);
+	bclear(&s2);
+	for (i = 0; i < NRUNS; i++) {
+		t0 = cycles();
+		send(getpid(), i);
+		t1 = cycles();
+		badd(&s1, t1 - t0);
+		t0 = cycles();
+		receive();
+		t1 = cycles();
+		badd(&s2, t1 - t0);
+	}
+	breport("send", &s1);
+	breport("receive", &s2);
+
+	/* sleepms(1): the whole call, including the wait for the tick */
+
+	bclear(&s1);
+	for (i = 0; i < NRUNS; i++) {
+		t0 = cycles();
+		sleepms(1);
+		t1 = cycles();
+		badd(&s1, t1 - t0);
+	}
+	breport("sleepms1", &s1);
+
+	/* Interrupt to task: from the Timer1 compare match to bwake	*/
+	/*   running (see birq)						*/
+
+	birq(&s1);
+	breport("irq2task", &s1);
+
+#if DWORK
+	/* The same match posting deferred work instead: to the start	*/
+	/*   of bdwfunc in the work daemon				*/
+
+	bdwirq = TRUE;
+	birq(&s1);
+	bdwirq = FALSE;
+	breport("irq2dwork", &s1);
+#endif
+
+	/* Audio handler at 5.5 kHz under load (see baudiorun)		*/
+
+	baudiorun();
+
+	/* Let the UART drain, then stop: simavr exits when the CPU	*/
+	/*   sleeps with interrupts disabled				*/
+
+	kprintf("BENCH # end\n");
+	sleepms(50);
+	cli();
+	set_sleep_mode(SLEEP_MODE_IDLE);
+	sleep_enable();
+	sleep_cpu();
+}
@@ -25,13 +25,14 @@ extern	const __flash struct dentry	devtab[] ; /* one entry per device */
 
 /* Device name definitions */
 
-#define CONSOLE              0	/* type null     */
+#define CONSOLE              0	/* type tty      */
 #define NULLDEV              1	/* type null     */
 #define NAMESPACE            2	/* type nam      */
 
 /* Control block sizes */
 
-#define	Nnull	2
+#define	Nnull	1
+#define	Ntty	1
 #define	Nnam	1
 
 #define NDEVS 3
@@ -39,5 +40,20 @@ extern	const __flash struct dentry	devtab[] ; /* one entry per device */
 
 /* Configuration and Size Constants */
 
-#define	NPROC	     5		/* number of user processes		*/
+#define	NPROC	     (5 + SWTIMER + DWORK + KLOG) /* processes: null, main,	*/
+				/*   3 XINU_TASKs and each daemon	*/
 #define	NSEM	     8		/* number of semaphores			*/
+#define	RDYBITMAP   0		/* 1 = O(1) priority bitmap ready list	*/
+#define	TICKLESS    0		/* 1 = stretch the tick while idle	*/
+#define	STKCHECK    0		/* 1 = check stack guard on each switch	*/
+#define	CPUACCT     0		/* 1 = per-process CPU time accounting	*/
+#define	TRACE       0		/* 1 = kernel event trace on CONSOLE	*/
+#define	NMPOOL      0		/* number of fixed-block pool classes	*/
+#define	MPSIZES     16, 32, 64	/* block size of each class (bytes)	*/
+#define	MPCOUNTS    4, 4, 2	/* blocks in each class			*/
+#define	KCOMPACT    0		/* 1 = RAM-compact kernel tables		*/
+#define	NMUTEX      0		/* number of priority-inheritance mutexes*/
+#define	SWTIMER     0		/* 1 = software timers with a daemon	*/
+#define	DWORK       0		/* 1 = deferred interrupt work daemon	*/
+#define	KLOG        0		/* 1 = binary deferred logging (klog)	*/
+#define	CONSOLEBAUD 9600	/* UART speed at boot (bits/s)		*/
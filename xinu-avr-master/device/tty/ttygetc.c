@@ -0,0 +1,25 @@
+/* ttygetc.c - ttygetc */
+
+#include <xinu.h>
+
+/*------------------------------------------------------------------------
+ *  ttygetc  -  Read one character from a tty device, blocking until one
+ *		  arrives.  A devcall is 8 bits, so a 0xff character comes
+ *		  back equal to SYSERR; use read() for binary data
+ *------------------------------------------------------------------------
+ */
+devcall	ttygetc(
+	  const __flash struct dentry *devptr	/* Entry in device switch table	*/
+	)
+{
+	struct	ttycblk	*typtr;		/* Pointer to ttytab entry	*/
+	char	ch;			/* Character to return		*/
+
+	typtr = &ttytab[devptr->dvminor];
+
+	/* Wait for a character in the buffer and extract it */
+
+	wait(typtr->tyisem);
+	ch = typtr->tyibuff[typtr->tyihead++ & (TY_IBUFLEN - 1)];
+	return (devcall)(byte)ch;
+}
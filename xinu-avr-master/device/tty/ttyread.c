@@ -0,0 +1,41 @@
+/* ttyread.c - ttyread */
+
+#include <xinu.h>
+
+/*------------------------------------------------------------------------
+ *  ttyread  -  Read character(s) from a tty device (interrupts disabled)
+ *------------------------------------------------------------------------
+ */
+devcall	ttyread(
+	  const __flash struct dentry *devptr,	/* Entry in device switch table	*/
+	  char	*buff,			/* Buffer of characters		*/
+	  int32	count 			/* Count of character to read	*/
+	)
+{
+	struct	ttycblk	*typtr;		/* Pointer to tty control block	*/
+	int32	avail;			/* Characters available in buff.*/
+	int32	nread;			/* Number of characters read	*/
+
+	typtr = &ttytab[devptr->dvminor];
+
+	if (count < 0) {
+		return SYSERR;
+	}
+
+	/* For count of zero, return all available characters */
+
+	if (count == 0) {
+		avail = (byte)(typtr->tyitail - typtr->tyihead);
+		if (avail == 0) {
+			return 0;
+		}
+		count = avail;
+	}
+
+	/* Read count characters, blocking for each one */
+
+	for (nread = 0; nread < count; nread++) {
+		*buff++ = (char) ttygetc(devptr);
+	}
+	return nread;
+}
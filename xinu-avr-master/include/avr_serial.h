@@ -8,14 +8,16 @@
  *
  **********************************************************************/
 
-#ifndef _SERIAL_H
-#define _SERIAL_H
+#ifndef _AVR_SERIAL_H
+#define _AVR_SERIAL_H
 
 void kserial_init(void);
+status kserial_setbaud(uint32 baud);
+uint32 kserial_getbaud(void);
 void kserial_put_char(char outputChar);
 char kserial_get_char(void);
 void kserial_put_str(char * outputStr);
 char* kserial_get_str(void);
 
 
-#endif /* _SERIAL_H */
+#endif /* _AVR_SERIAL_H */
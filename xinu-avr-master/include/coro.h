@@ -0,0 +1,96 @@
+/* coro.h - CO_BEGIN, CO_END, CO_YIELD, CO_WAIT_UNTIL, CO_SLEEP,	*/
+/*	    CO_WAIT_SEM, CO_WAIT_EVENT, CO_EXIT				*/
+
+/* Stackless coroutines.  Many small polling tasks can share one Xinu	*/
+/*   process: each is a function that corun() calls over and over and	*/
+/*   that resumes where it last returned (the line number is kept in	*/
+/*   colc and a switch jumps back to it).  A coroutine costs a struct	*/
+/*   coro instead of a process table entry and a stack, but its local	*/
+/*   variables do not survive a wait (use static ones or fields of a	*/
+/*   struct that embeds the coro), and it cannot use a switch around a	*/
+/*   wait or block in a system call:					*/
+/*									*/
+/*	char	blink(struct coro *co)					*/
+/*	{								*/
+/*		CO_BEGIN(co);						*/
+/*		while (TRUE) {						*/
+/*			led_toggle();					*/
+/*			CO_SLEEP(co, 500);				*/
+/*		}							*/
+/*		CO_END(co);						*/
+/*	}								*/
+/*									*/
+/*   When no coroutine could run, the process waits (notifywait) until	*/
+/*   the first CO_SLEEP expires, cosignal() posts an event, or COPOLLMS	*/
+/*   ms pass so that CO_WAIT_UNTIL and CO_WAIT_SEM conditions are	*/
+/*   checked again.							*/
+
+#ifndef	COPOLLMS
+#define	COPOLLMS	10	/* Longest idle wait between passes	*/
+#endif
+
+#define	CONOTE		0x8000	/* Notification bit used by corun	*/
+
+/* Values returned by a coroutine function */
+
+#define	CO_WAITING	0	/* Blocked on a condition		*/
+#define	CO_YIELDED	1	/* Gave up the CPU, can run again	*/
+#define	CO_EXITED	2	/* Finished with CO_EXIT		*/
+#define	CO_ENDED	3	/* Reached CO_END			*/
+
+struct	coro	{
+	struct	coro	*conext;	/* Next coroutine in the process*/
+	char	(*cofunc)(struct coro *);/* Coroutine function		*/
+	uint16	colc;			/* Line to resume at (0 = start)*/
+	uint32	cowake;			/* CO_SLEEP end (clkticks)	*/
+	bool8	cosleep;		/* cowake is valid		*/
+	byte	coevents;		/* Events posted by cosignal	*/
+	int16	copid;			/* Process running the coroutine*/
+};
+
+struct	cosched	{
+	struct	coro	*cohead;	/* Coroutines run by corun	*/
+};
+
+#define	CO_BEGIN(co)	{ bool8 coyield = TRUE; (void)coyield;		\
+			  switch ((co)->colc) { case 0:
+
+#define	CO_END(co)	} (co)->colc = 0; return CO_ENDED; }
+
+#define	CO_EXIT(co)	do { (co)->colc = 0; return CO_EXITED; } while (0)
+
+#define	CO_WAIT_UNTIL(co, cond)						\
+	do {								\
+		(co)->colc = __LINE__; case __LINE__:			\
+		if (!(cond)) {						\
+			return CO_WAITING;				\
+		}							\
+	} while (0)
+
+#define	CO_YIELD(co)							\
+	do {								\
+		coyield = FALSE;					\
+		(co)->colc = __LINE__; case __LINE__:			\
+		if (!coyield) {						\
+			return CO_YIELDED;				\
+		}							\
+	} while (0)
+
+#define	CO_SLEEP(co, ms)						\
+	do {								\
+		(co)->cowake = getticks() + (ms);			\
+		(co)->cosleep = TRUE;					\
+		CO_WAIT_UNTIL(co,					\
+			(int32)(getticks() - (co)->cowake) >= 0);	\
+		(co)->cosleep = FALSE;					\
+	} while (0)
+
+#define	CO_WAIT_SEM(co, sem)	CO_WAIT_UNTIL(co, semtry(sem) == OK)
+
+/* Wait for any of the event bits, then clear the ones that were set */
+
+#define	CO_WAIT_EVENT(co, bits)						\
+	do {								\
+		CO_WAIT_UNTIL(co, ((co)->coevents & (bits)) != 0);	\
+		coclear(co, bits);					\
+	} while (0)
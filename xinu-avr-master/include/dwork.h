@@ -0,0 +1,45 @@
+/* dwork.h - DWORK_INIT */
+
+/* Deferred interrupt work.  An interrupt handler does only what must	*/
+/*   happen at once, posts a work item with dwpost_isr() and ends with	*/
+/*   isr_exit(); the work daemon, the highest priority process, then	*/
+/*   runs the item's function with interrupts enabled before any other	*/
+/*   process.  Items are static and keep their own latency figures:	*/
+/*									*/
+/*	struct dwork scorework = DWORK_INIT(score_update, NULL);	*/
+/*	ISR(INT0_vect) { dwpost_isr(&scorework); isr_exit(); }		*/
+/*									*/
+/*   An item posted again before it ran is run once (dwmerged counts	*/
+/*   those posts).  The daemon is a static task (DWDSTACK bytes of	*/
+/*   stack, priority DWDPRIO) whose process table slot conf.h adds to	*/
+/*   NPROC.								*/
+
+#ifndef	DWORK
+#define	DWORK		0	/* 1 = deferred interrupt work daemon	*/
+#endif
+
+#ifndef	DWDSTACK
+#define	DWDSTACK	96	/* Work daemon stack (bytes)		*/
+#endif
+
+#ifndef	DWDPRIO
+#define	DWDPRIO		40	/* Work daemon priority (above all)	*/
+#endif
+
+#define	DWNOTE		0x01	/* Notification bit for the daemon	*/
+
+struct	dwork	{
+	struct	dwork	*dwnext;	/* Next pending item		*/
+	void	(*dwfunc)(void *);	/* Work to do			*/
+	void	*dwarg;			/* Argument for dwfunc		*/
+	bool8	dwpending;		/* Posted and not yet run	*/
+	uint32	dwposted;		/* getmicros() when posted	*/
+	uint16	dwruns;			/* Times run			*/
+	uint16	dwmerged;		/* Posts merged into a pending run*/
+	uint32	dwmaxlat;		/* Worst post-to-start time (us)*/
+	uint32	dwtotlat;		/* Sum of post-to-start times	*/
+};
+
+#define	DWORK_INIT(func, arg)	{ NULL, (func), (arg) }
+
+extern	struct	xtask	dwd_xtask;	/* Work daemon (XINU_TASK)	*/
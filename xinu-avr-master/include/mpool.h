@@ -0,0 +1,41 @@
+/* mpool.h - fixed-block memory pools */
+
+/* Fixed-size block pools, one per size class.  Each class is a single	*/
+/*   arena carved from the heap at startup and threaded into a free	*/
+/*   list, so allocation and release take constant time.  getmem() and	*/
+/*   getstk() take a block from the smallest class that fits before	*/
+/*   falling back to the heap, and freemem() returns pool blocks to	*/
+/*   their class.  mpget() and mpfree() never touch the heap and may be	*/
+/*   called from interrupt handlers.					*/
+
+#ifndef	NMPOOL
+#define	NMPOOL		0	/* Number of size classes (0 = none)	*/
+#endif
+
+#if NMPOOL > 0
+
+#ifndef	MPSIZES
+#error "MPSIZES must list the block size of each class"
+#endif
+#ifndef	MPCOUNTS
+#error "MPCOUNTS must list the number of blocks in each class"
+#endif
+
+struct	mpclass	{		/* One size class			*/
+	uint16	mpsize;		/* Block size in bytes (multiple of 8)	*/
+	uint16	mpcount;	/* Number of blocks in the arena	*/
+	char	*mpbase;	/* First block of the arena		*/
+	char	*mpflist;	/* Head of the free list		*/
+	uint16	mpnfree;	/* Blocks now free			*/
+	uint16	mpminfree;	/* Fewest blocks ever free		*/
+	uint16	mpspill;	/* Requests served by a larger class	*/
+	uint16	mpfails;	/* Requests no class could serve	*/
+	uint32	mpasked;	/* Bytes requested from this class	*/
+	uint32	mpgiven;	/* Bytes handed out by this class	*/
+};
+
+extern	struct	mpclass	mptab[];
+
+#define	MPNOTPOOL	(-4)	/* mpfree: address is in no arena	*/
+
+#endif
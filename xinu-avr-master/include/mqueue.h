@@ -0,0 +1,32 @@
+/* mqueue.h - MQ_DEFINE, mq_highwater */
+
+/* Message queues: a fixed number of fixed-size messages copied in and	*/
+/*   out of a buffer, with senders blocking while the queue is full and	*/
+/*   receivers while it is empty.  Queues are allocated statically:	*/
+/*									*/
+/*	MQ_DEFINE(animq, sizeof(struct anim), 4);			*/
+/*	...								*/
+/*	mq_init(&animq);		creates the two semaphores	*/
+/*	mq_send(&animq, &a);		mq_recv(&animq, &a);		*/
+/*									*/
+/*   mq_send_isr() never blocks: it fails with SYSERR if the queue is	*/
+/*   full (counted in mqfull).  mqmax records the deepest the queue	*/
+/*   has been, for sizing the depth.					*/
+
+struct	mqueue	{
+	byte	*mqbuf;		/* mqdepth slots of mqsize bytes	*/
+	byte	mqsize;		/* Bytes per message			*/
+	byte	mqdepth;	/* Maximum messages queued		*/
+	byte	mqhead;		/* Slot of the oldest message		*/
+	byte	mqcount;	/* Messages queued			*/
+	byte	mqmax;		/* High-water mark of mqcount		*/
+	uint16	mqfull;		/* mq_send_isr calls refused		*/
+	sid32	mqitems;	/* Counts queued messages		*/
+	sid32	mqspaces;	/* Counts free slots			*/
+};
+
+#define	MQ_DEFINE(name, size, depth)					\
+	static	byte	name##_mqbuf[(size) * (depth)];			\
+	struct	mqueue	name = { name##_mqbuf, (size), (depth) }
+
+#define	mq_highwater(mq)	((mq)->mqmax)
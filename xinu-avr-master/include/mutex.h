@@ -0,0 +1,27 @@
+/* mutex.h - isbadmut */
+
+/* Mutexes are owned locks for shared peripherals.  A process blocked	*/
+/*   on a mutex lends its priority to the owner (priority inheritance),	*/
+/*   and a mutex created with a ceiling raises its owner to at least	*/
+/*   that priority while held (immediate priority ceiling).  NMUTEX	*/
+/*   (see process.h) set to 0 leaves them out.				*/
+
+/* Mutex state definitions */
+
+#define	MU_FREE		0	/* Mutex table entry is available	*/
+#define	MU_USED		1	/* Mutex table entry is in use		*/
+
+#define	MUNOCEIL	0	/* mutcreate(): inheritance only	*/
+
+/* Mutex table entry */
+struct	mutent	{
+	byte	mustate;	/* Whether entry is MU_FREE or MU_USED	*/
+	int16	muowner;	/* Process holding the mutex or EMPTY	*/
+	pri16	muceil;		/* Ceiling priority or MUNOCEIL		*/
+	qid16	muqueue;	/* Waiting processes, highest priority	*/
+				/*     first				*/
+};
+
+extern	struct	mutent mutab[];
+
+#define	isbadmut(m)	((int32)(m) < 0 || (m) >= NMUTEX)
@@ -0,0 +1,17 @@
+/* pregs.h - layout of the register save area (procent.pregs) */
+
+/* avr specific: ctxsw is only called from C (resched), so it saves	*/
+/*   just what the avr-gcc ABI expects to survive a call: r2-r17, r28,	*/
+/*   r29, SP and SREG.  r22-r25 are loaded but never saved; create	*/
+/*   puts the arguments of a new process there for its first run.	*/
+/*   The PC is the return address on the process's stack.  This file	*/
+/*   holds only #defines so that ctxsw.S can include it as well.	*/
+
+#define	SR2		0	/* r2-r17, 16 bytes			*/
+#define	SR28		16	/* r28, r29 (frame pointer)		*/
+#define	SR22		18	/* r22, r23: argv of a new process	*/
+#define	SR24		20	/* r24, r25: nargs of a new process	*/
+#define	SSP_L		22	/* saved SP (low)			*/
+#define	SSP_H		23	/* saved SP (high)			*/
+#define	SSREG		24	/* saved Status Register		*/
+#define	PNREGS		25	/* size of saved register area		*/
@@ -29,6 +29,10 @@ extern	uint32	clkcount(void);
 /* in file clkhandler.c */
 extern	interrupt clkhandler(void);
 
+/* in file clkidle.c */
+extern	void	clkidle(void);
+extern	void	clkresume(void);
+
 /* in file clkinit.c */
 extern	void	clkinit(void);
 
@@ -41,9 +45,22 @@ extern	syscall	close(did32);
 /* in file control.c */
 extern	syscall	control(did32, int32, int32, int32);
 
+/* in file cpuacct.c */
+extern	void	cpureport(void);
+extern	process	cpumon(void);
+
 /* in file create.c */
+extern	pid32	createat(int (*)(), byte *, int, int, char *);
 extern	pid32	create(int (*procaddr)(), int, int, char *, int, ...);
 
+/* in file coro.c */
+extern	syscall	costart(struct cosched *, struct coro *,
+			char (*)(struct coro *));
+extern	void	corun(struct cosched *);
+extern	syscall	cosignal(struct coro *, byte);
+extern	syscall	cosignal_isr(struct coro *, byte);
+extern	void	coclear(struct coro *, byte);
+
 /* in file ctxsw.S */
 extern	void	ctxsw(void *, void *);
 
@@ -56,6 +73,11 @@ extern	uint32	dnslookup(char *);
 /* in file dot2ip.c */
 extern	uint32	dot2ip(char *, uint32 *);
 
+/* in file dwork.c */
+extern	syscall	dwpost_isr(struct dwork *);
+extern	syscall	dwpost(struct dwork *);
+extern	void	dwreport(struct dwork *, char *);
+
 /* in file ethcontrol.c */
 extern	int32	ethcontrol(struct dentry *, int32, int32, int32);
 
@@ -112,6 +134,7 @@ extern	char	*getstk(uint32);
 
 /* in file getticks.c */
 extern	uint32	getticks(void);
+extern	uint32	getmicros(void);
 
 /* in file gettime.c */
 extern	status	gettime(uint32 *);
@@ -144,7 +167,8 @@ extern	status	insert(pid32, qid16, char);
 
 /* in file insertd.c */
 // extern	status	insertd(pid32, qid16, int32);
-extern	status	insertd(pid32, qid16, uint16);
+extern	status	insertd(pid32, qid16, uint32);
+extern	void	insertdelta(pid32, qid16, uint16);
 
 /* in file intr.S */
 extern	intmask	disable(void);
@@ -177,9 +201,19 @@ extern	void	eth_hton(struct netpacket *);
 extern	void	eth_ntoh(struct netpacket *);
 extern	uint16	getport(void);
 
+/* in file isr.c */
+extern	syscall	signal_isr(sid32);
+extern	syscall	send_isr(pid32, umsg32);
+extern	syscall	notify_isr(pid32, uint16);
+extern	void	isr_ready(pid32);
+extern	void	isr_exit(void);
+
 /* in file kill.c */
 extern	syscall	kill(pid32);
 
+/* in file klog.c */
+extern	void	klogf(const __flash char *, ...);
+
 /* in file lexan.c */
 extern	int32	lexan(char *, int32, char *, int32 *, int32 [], int32 []);
 
@@ -298,9 +332,36 @@ extern	status	namcpy(char *, char *, int32);
 // extern	devcall	namopen(struct dentry *, char *, char *);
 extern	devcall	namopen(const __flash struct dentry *, char *, char *);
 
+/* in file mpool.c */
+extern	status	mpinit(void);
+extern	char	*mpget(uint32);
+extern	syscall	mpfree(char *);
+extern	void	mpreport(void);
+
+/* in file mqueue.c */
+extern	status	mq_init(struct mqueue *);
+extern	syscall	mq_send(struct mqueue *, const void *);
+extern	syscall	mq_send_isr(struct mqueue *, const void *);
+extern	syscall	mq_recv(struct mqueue *, void *);
+extern	syscall	mq_recv_timeout(struct mqueue *, void *, int32);
+
+/* in file mutex.c */
+extern	void	mutinit(void);
+extern	mid16	mutcreate(pri16);
+extern	syscall	mutdelete(mid16);
+extern	syscall	mutlock(mid16);
+extern	syscall	mutunlock(mid16);
+extern	void	mutkill(pid32);
+extern	pri16	mutprio(pid32);
+extern	void	prioupdate(pid32);
+
 /* in file newqueue.c */
 extern	qid16	newqueue(void);
 
+/* in file notify.c */
+extern	syscall	notify(pid32, uint16);
+extern	int32	notifywait(uint16, int32);
+
 /* in file open.c */
 extern	syscall	open(did32, char *, char *);
 
@@ -314,6 +375,11 @@ extern	int32	pci_init(void);
 extern	void	pdump(struct netpacket *);
 extern	void	pdumph(struct netpacket *);
 
+/* in file periodic.c */
+extern	syscall	periodic_init(struct periodic *, uint16);
+extern	syscall	periodic_wait(struct periodic *);
+extern	uint16	getoverrun(pid32);
+
 /* in file platinit.c */
 extern	void	platinit(void);
 
@@ -377,6 +443,15 @@ extern	status	rdscomm(struct rd_msg_hdr *, int32, struct rd_msg_hdr *,
 /* in file rdsprocess.c */
 extern	void	rdsprocess(struct rdscblk *);
 
+/* in file rdybitmap.c */
+#if RDYBITMAP
+extern	void	rdyinit(void);
+extern	status	rdyinsert(pid32, pri16);
+extern	pid32	rdyremove(pid32);
+extern	pid32	rdydequeue(void);
+extern	int16	rdyfirstkey(void);
+#endif
+
 /* in file read.c */
 extern	syscall	read(did32, char *, uint32);
 
@@ -468,6 +543,12 @@ extern	status	rdscomm(struct rd_msg_hdr *, int32, struct rd_msg_hdr *, int32, st
 /* in file rdsprocess.c */
 extern	void	rdsprocess(struct rdscblk *);
 
+/* in file ring.c */
+extern	status	ringinit(struct ringhdr *, bool8);
+extern	void	ringwait(struct ringhdr *);
+extern	void	ringwake(struct ringhdr *);
+extern	void	ringwake_isr(struct ringhdr *);
+
 /* in file seek.c */
 extern	syscall	seek(did32, uint32);
 
@@ -483,6 +564,9 @@ extern	syscall	semdelete(sid32);
 /* in file semreset.c */
 extern	syscall	semreset(sid32, int32);
 
+/* in file semtry.c */
+extern	syscall	semtry(sid32);
+
 /* in file send.c */
 extern	syscall	send(pid32, umsg32);
 
@@ -498,6 +582,7 @@ extern	syscall	signaln(sid32, int32);
 /* in file sleep.c */
 extern	syscall	sleepms(int32);
 extern	syscall	sleep(int32);
+extern	syscall	sleepuntil(uint32);
 
 /* in file spicontrol.c */
 extern	devcall	spicontrol(struct dentry *, int32, int32, int32);
@@ -515,9 +600,22 @@ extern	int32	outl(int32, int32);
 extern	int32	outsw(int32, int32, int32);
 extern	int32	insw(int32, int32 ,int32);
 
+/* in file stkusage.c */
+extern	bool8	stkcheck(struct procent *);
+extern	void	stkoverflow(pid32);
+extern	int32	stkusage(pid32);
+extern	void	stkreport(void);
+extern	process	stkmon(void);
+
 /* in file suspend.c */
 extern	syscall	suspend(pid32);
 
+/* in file swtimer.c */
+extern	syscall	tmstart(struct swtimer *, uint32, uint16, void (*)(void *),
+			void *);
+extern	syscall	tmstop(struct swtimer *);
+extern	void	tmnotify(void);
+
 /* in file ttycontrol.c */
 // extern	devcall	ttycontrol(struct dentry *, int32, int32, int32);
 extern	devcall	ttycontrol(const __flash struct dentry *, int32, int32, int32);
@@ -526,21 +624,12 @@ extern	devcall	ttycontrol(const __flash struct dentry *, int32, int32, int32);
 // extern	devcall	ttygetc(struct dentry *);
 extern	devcall	ttygetc(const __flash struct dentry *);
 
-/* in file ttyhandle_in.c */
-extern	void	ttyhandle_in(struct ttycblk *, struct uart_csreg *, char c);
-
-/* in file ttyhandle_out.c */
-extern	void	ttyhandle_out(struct ttycblk *, struct uart_csreg *);
-
-/* in file ttyhandler.c */
-extern	void	ttyhandler(uint32, char c, int tipo);
-
 /* in file ttyinit.c */
 // extern	devcall	ttyinit(struct dentry *);
 extern	devcall	ttyinit(const __flash struct dentry *);
 
 /* in file ttykickout.c */
-extern	void	ttykickout(struct uart_csreg *);
+extern	void	ttykickout(void);
 
 /* in file ttyputc.c */
 // extern	devcall	ttyputc(struct dentry *, char);
@@ -568,6 +657,14 @@ extern	void	udp_ntoh(struct netpacket *);
 extern	void	udp_hton(struct netpacket *);
 
 
+/* in file trace.c */
+#if TRACE
+extern	void	tracerec(byte, byte);
+extern	void	tracerecclk(byte);
+extern	void	tracedrain(void);
+extern	bool8	tracepending(void);
+#endif
+
 /* in file unsleep.c */
 extern	syscall	unsleep(pid32);
 
@@ -577,6 +674,10 @@ extern	void	userret(void);
 /* in file wait.c */
 extern	syscall	wait(sid32);
 
+/* in file waittime.c */
+extern	syscall	waittime(sid32, int32);
+extern	pid32	semdequeue(sid32);
+
 /* in file wakeup.c */
 extern	void	wakeup(void);
 
@@ -586,6 +687,9 @@ extern	syscall	write(did32, char *, uint32);
 /* in file xdone.c */
 extern	void	xdone(void);
 
+/* in file xtask.c */
+extern	void	xtaskinit(void);
+
 /* in file yield.c */
 extern	syscall	yield(void);
 
@@ -3,24 +3,46 @@
 /* Queue structure declarations, constants, and inline functions	*/
 
 /* Default # of queue entries: 1 per process plus 2 for ready list plus	*/
-/*			2 for sleep list plus 2 per semaphore		*/
+/*			2 for sleep list plus 2 per semaphore and mutex	*/
+/*   (the bitmap ready list keeps its FIFO heads outside queuetab)	*/
 #ifndef NQENT
-#define NQENT	(NPROC + 4 + NSEM + NSEM)
+#if RDYBITMAP
+#define NQENT	(NPROC + 2 + NSEM + NSEM + NMUTEX + NMUTEX)
+#else
+#define NQENT	(NPROC + 4 + NSEM + NSEM + NMUTEX + NMUTEX)
+#endif
 #endif
 
 #define	EMPTY	(-1)		/* Null value for qnext or qprev index	*/
 #define	MAXKEY	0x7FFFFFFF	/* Max key that can be stored in queue	*/
 #define	MINKEY	0x80000000	/* Min key that can be stored in queue	*/
 
+#if KCOMPACT
+#if NQENT > 127
+#error "KCOMPACT keeps queue links in a signed byte"
+#endif
+struct	qentry	{		/* One per process plus two per list	*/
+	uint16	qkey;		/* Key on which the queue is ordered	*/
+	signed char qnext;	/* Index of next process or tail	*/
+	signed char qprev;	/* Index of previous process or head	*/
+};
+#else
 struct	qentry	{		/* One per process plus two per list	*/
 	uint16	qkey;		/* Key on which the queue is ordered	*/
 //	int32	qkey;		/* Key on which the queue is ordered	*/
 	qid16	qnext;		/* Index of next process or tail	*/
 	qid16	qprev;		/* Index of previous process or head	*/
 };
+#endif
 
 extern	struct qentry	queuetab[];
 
+/* Delta keys are 16 bits; longer sleeps are split into SLCHUNK ms	*/
+/*   periods counted in the process table (see insertd and wakeup)	*/
+
+#define	SLSHIFT		15
+#define	SLCHUNK		((uint32)1 << SLSHIFT)
+
 /* Inline queue manipulation functions */
 
 #define	queuehead(q)	(q)
@@ -0,0 +1,104 @@
+/* ring.h - RING_DEFINE */
+
+/* Lock-free single-producer/single-consumer ring buffers for passing	*/
+/*   data from an interrupt handler to a process (or the other way).	*/
+/*   Each side only writes its own 8-bit index, which the AVR stores	*/
+/*   atomically, so neither put nor get needs disable().  A ring type	*/
+/*   and its functions are generated for any element type:		*/
+/*									*/
+/*	RING_DEFINE(audioq, byte, 64)	-> struct audioq, audioq_put()	*/
+/*	RING_DEFINE(adcq, uint16, 16)	   audioq_get(), audioq_count()	*/
+/*	RING_DEFINE(evq, struct ev, 8)	   audioq_init(), audioq_getw(),*/
+/*					   audioq_put_isr()		*/
+/*									*/
+/*   The size must be a power of 2 no larger than 128.  If the ring is	*/
+/*   initialized with blocking set, name_getw() waits on a semaphore	*/
+/*   when the ring is empty and the producer signals it only then.  An	*/
+/*   interrupt handler puts with name_put_isr(), which releases the	*/
+/*   consumer with signal_isr(), and must end with isr_exit().		*/
+
+struct	ringhdr	{
+	volatile byte	rhead;	/* Free-running put index (producer)	*/
+	volatile byte	rtail;	/* Free-running get index (consumer)	*/
+	volatile bool8	rwait;	/* Consumer is blocked on rsem		*/
+	sid32		rsem;	/* Semaphore for name_getw, or SYSERR	*/
+};
+
+/* Keep the compiler from moving element accesses across an index update*/
+
+#define	ringbarrier()	__asm__ __volatile__ ("" ::: "memory")
+
+#define	RING_DEFINE(name, type, size)					\
+									\
+typedef	char	name##_sizecheck[((size) & ((size) - 1)) == 0		\
+				&& (size) <= 128 ? 1 : -1];		\
+									\
+struct	name	{							\
+	struct	ringhdr	rh;						\
+	type	rbuf[size];						\
+};									\
+									\
+static	inline	status	name##_init(struct name *r, bool8 blocking)	\
+{									\
+	return ringinit(&r->rh, blocking);				\
+}									\
+									\
+static	inline	byte	name##_count(struct name *r)			\
+{									\
+	return (byte)(r->rh.rhead - r->rh.rtail);			\
+}									\
+									\
+static	inline	bool8	name##_store(struct name *r, type v)		\
+{									\
+	byte	head = r->rh.rhead;					\
+									\
+	if ((byte)(head - r->rh.rtail) >= (size)) {			\
+		return FALSE;		/* Full				*/	\
+	}								\
+	r->rbuf[head & ((size) - 1)] = v;				\
+	ringbarrier();							\
+	r->rh.rhead = head + 1;						\
+	return TRUE;							\
+}									\
+									\
+static	inline	bool8	name##_put(struct name *r, type v)		\
+{									\
+	if (!name##_store(r, v)) {					\
+		return FALSE;						\
+	}								\
+	if (r->rh.rwait) {						\
+		ringwake(&r->rh);					\
+	}								\
+	return TRUE;							\
+}									\
+									\
+static	inline	bool8	name##_put_isr(struct name *r, type v)		\
+{									\
+	if (!name##_store(r, v)) {					\
+		return FALSE;						\
+	}								\
+	if (r->rh.rwait) {						\
+		ringwake_isr(&r->rh);					\
+	}								\
+	return TRUE;							\
+}									\
+									\
+static	inline	bool8	name##_get(struct name *r, type *v)		\
+{									\
+	byte	tail = r->rh.rtail;					\
+									\
+	if (r->rh.rhead == tail) {					\
+		return FALSE;		/* Empty			*/	\
+	}								\
+	*v = r->rbuf[tail & ((size) - 1)];				\
+	ringbarrier();							\
+	r->rh.rtail = tail + 1;						\
+	return TRUE;							\
+}									\
+									\
+static	inline	void	name##_getw(struct name *r, type *v)		\
+{									\
+	while (!name##_get(r, v)) {					\
+		ringwait(&r->rh);					\
+	}								\
+}
@@ -14,9 +14,15 @@ extern	int32	fscanf(int32, char *, int32);
 
 /* Definintion of standard input/ouput/error used with shell commands */
 
+#if NDESC > 0
 #define	stdin	((proctab[currpid]).prdesc[0])
 #define	stdout	((proctab[currpid]).prdesc[1])
 #define	stderr	((proctab[currpid]).prdesc[2])
+#else
+#define	stdin	CONSOLE
+#define	stdout	CONSOLE
+#define	stderr	CONSOLE
+#endif
 
 
 /* Prototypes for formatted output functions */
@@ -1,9 +1,16 @@
 /*General purpose timer */
 
-extern	unsigned long	clktime;   /* current time in secs since boot	*/
-extern  unsigned long  count1000;  /* ms since last clock tick          */
+#ifndef	TICKLESS
+#define	TICKLESS	0	/* 1 = null process stretches the tick	*/
+#endif
+
+extern	uint32	clktime;   /* current time in secs since boot	*/
+extern  uint32  count1000;  /* ms since last clock tick          */
 
 extern	qid16	sleepq;		/* queue for sleeping processes		*/
 extern	int32	slnonempty;	/* nonzero if sleepq is nonempty	*/
 extern	int32	*sltop;		/* ptr to key in first item on sleepq	*/
 extern	uint32	preempt;	/* preemption counter 			*/
+extern	uint32	clkticks;	/* ms since boot (monotonic)		*/
+extern	uint16	clkperiod;	/* ms per TIMER2 interrupt (tickless)	*/
+extern	bool8	isrresched;	/* reschedule due at isr_exit (isr.c)	*/
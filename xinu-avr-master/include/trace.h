@@ -0,0 +1,80 @@
+/* trace.h - trace */
+
+/* Kernel event trace.  With TRACE set, the kernel records scheduling	*/
+/*   events in a RAM ring buffer and the null process queues them on	*/
+/*   CONSOLE, a whole event at a time and only when the tty output	*/
+/*   queue has room for it, so the trace goes out while the system is	*/
+/*   idle and a process writing to CONSOLE always comes first.  The	*/
+/*   bytes skip the tty's output editing (no CR before LF).  Each	*/
+/*   event goes out as TREVBYTES bytes:					*/
+/*									*/
+/*	TRSYNC  type  arg  tick  tcnt					*/
+/*									*/
+/*   where tick is the low byte of clkticks and tcnt is TCNT2 (8 us	*/
+/*   per count).  tools/tracedec turns a capture into a timeline.	*/
+/*									*/
+/*   CONSOLE is on UART0, the same line that links the master and	*/
+/*   slave boards, so the trace cannot be used while the boards talk	*/
+/*   to each other; other CONSOLE output lands between events, and	*/
+/*   tracedec skips it by looking for TRSYNC.  At 9600 baud the line	*/
+/*   carries about 190 events per second; the clock interrupt alone	*/
+/*   would make 2000 (TR_ISRIN and TR_ISROUT every ms) and leave	*/
+/*   nothing but TR_LOST, so it is recorded once every TRACECLK ms.	*/
+/*   tracedec needs an event at least every 256 ms to rebuild the	*/
+/*   time, so TRACECLK is at most 128.					*/
+
+#ifndef	TRACE
+#define	TRACE		0
+#endif
+
+#ifndef	TRACELEN
+#define	TRACELEN	32	/* Events in the ring (power of 2)	*/
+#endif
+
+#ifndef	TRACECLK
+#define	TRACECLK	128	/* ms between traced clock interrupts	*/
+#endif
+
+#define	TRSYNC		0x7e	/* First byte of every event on the wire*/
+#define	TREVBYTES	5	/* Bytes per event on the wire		*/
+
+/* Event types and their argument */
+
+#define	TR_CTXSW	1	/* (old pid << 4) | new pid		*/
+#define	TR_WAIT		2	/* Semaphore ID				*/
+#define	TR_SIGNAL	3	/* Semaphore ID				*/
+#define	TR_ISRIN	4	/* Interrupt number (TR_IRQ...)		*/
+#define	TR_ISROUT	5	/* Interrupt number			*/
+#define	TR_SLEEP	6	/* Process ID				*/
+#define	TR_WAKEUP	7	/* Process ID				*/
+#define	TR_LOST		8	/* Events dropped while the ring was full*/
+
+#define	TR_IRQCLK	0	/* TIMER2 compare A (clkhandler)	*/
+
+#if TRACE
+
+#if NPROC > 16
+#error "TR_CTXSW packs two process IDs in one byte"
+#endif
+
+struct	trevent	{		/* One recorded event			*/
+	byte	trtype;		/* Event type (TR_...)			*/
+	byte	trarg;		/* Argument, depends on the type	*/
+	byte	trtick;		/* Low byte of clkticks			*/
+	byte	trtcnt;		/* TCNT2 when recorded			*/
+};
+
+#if TRACECLK < 1 || TRACECLK > 128
+#error "TRACECLK must be 1 to 128 ms"
+#endif
+
+#define	trace(type, arg)	tracerec((type), (arg))
+#define	traceclk(type)		tracerecclk(type)
+
+#else
+
+#define	trace(type, arg)
+#define	traceclk(type)
+#define	tracepending()		FALSE
+
+#endif
@@ -2,14 +2,10 @@
 
 /* avr specific values. Original saved under orig/ folder */
 
-#define	TY_OBMINSP	1		/* Min space in buffer before	*/
-					/*   processes awakened to write*/
-#define	TY_EBUFLEN	1		/* Size of echo queue		*/
-
 /* Size constants */
 
 #ifndef	Ntty
-#define	Ntty		1		/* Number of serial tty lines	*/
+#define	Ntty		0		/* Number of serial tty lines	*/
 #endif
 #ifndef	TY_IBUFLEN
 #define	TY_IBUFLEN	32		/* Num. chars in input queue	*/
@@ -17,6 +13,9 @@
 #ifndef	TY_OBUFLEN
 #define	TY_OBUFLEN	8		/* Num.	chars in output	queue	*/
 #endif
+#ifndef	CONSOLEBAUD
+#define	CONSOLEBAUD	9600		/* UART speed at boot (bits/s)	*/
+#endif
 
 /* Mode constants for input and output modes */
 
@@ -25,38 +24,29 @@
 #define	TY_IMCBREAK	'K'		/* Honor echo, etc, no line edit*/
 #define	TY_OMRAW	'R'		/* Raw output mode => no edits	*/
 
+/* avr specific: the queues use free-running 8-bit indices, as in	*/
+/*   ring.h, so their sizes must be powers of 2 no larger than 128.	*/
+/*   Input is filled by the receive interrupt and counted by tyisem;	*/
+/*   output is drained by the data register empty interrupt and its	*/
+/*   free slots are counted by tyosem.  There is no cooked mode.	*/
+
 struct	ttycblk	{			/* Tty line control block	*/
-	char	*tyihead;		/* Next input char to read	*/
-	char	*tyitail;		/* Next slot for arriving char	*/
-	char	tyibuff[TY_IBUFLEN];	/* Input buffer (holds one line)*/
+	volatile byte	tyihead;	/* Next input char to read	*/
+	volatile byte	tyitail;	/* Next slot for arriving char	*/
+	char	tyibuff[TY_IBUFLEN];	/* Input buffer			*/
 	sid32	tyisem;			/* Input semaphore		*/
-	char	*tyohead;		/* Next output char to xmit	*/
-	char	*tyotail;		/* Next slot for outgoing char	*/
+	volatile byte	tyohead;	/* Next output char to xmit	*/
+	volatile byte	tyotail;	/* Next slot for outgoing char	*/
 	char	tyobuff[TY_OBUFLEN];	/* Output buffer		*/
 	sid32	tyosem;			/* Output semaphore		*/
-	char	*tyehead;		/* Next echo char to xmit	*/
-	char	*tyetail;		/* Next slot to deposit echo ch	*/
-	char	tyebuff[TY_EBUFLEN];	/* Echo buffer			*/
-	char	tyimode;		/* Input mode raw/cbreak/cooked	*/
+	char	tyimode;		/* Input mode raw/cbreak	*/
 	bool8	tyiecho;		/* Is input echoed?		*/
-	bool8	tyieback;		/* Do erasing backspace on echo?*/
-	bool8	tyevis;			/* Echo control chars as ^X ?	*/
-	bool8	tyecrlf;		/* Echo CR-LF for newline?	*/
 	bool8	tyicrlf;		/* Map '\r' to '\n' on input?	*/
-	bool8	tyierase;		/* Honor erase character?	*/
-	char	tyierasec;		/* Primary erase character	*/
-	char	tyierasec2;		/* Alternate erase character	*/
-	bool8	tyeof;			/* Honor EOF character?		*/
-	char	tyeofch;		/* EOF character (usually ^D)	*/
-	bool8	tyikill;		/* Honor line kill character?	*/
-	char	tyikillc;		/* Line kill character		*/
-	int32	tyicursor;		/* Current cursor position	*/
-	bool8	tyoflow;		/* Honor ostop/ostart?		*/
-	bool8	tyoheld;		/* Output currently being held?	*/
-	char	tyostop;		/* Character that stops output	*/
-	char	tyostart;		/* Character that starts output	*/
 	bool8	tyocrlf;		/* Output CR/LF for LF ?	*/
-	char	tyifullc;		/* Char to send when input full	*/
+	uint16	tyiovr;			/* Input chars dropped because	*/
+					/*   the input buffer was full	*/
+	uint16	tyihwovr;		/* Input chars lost in the UART	*/
+					/*   (data overrun, DOR0)	*/
 };
 extern	struct	ttycblk	ttytab[];
 
@@ -84,3 +74,13 @@ extern	struct	ttycblk	ttytab[];
 #define	TC_ICHARS	8		/* Return number of input chars	*/
 #define	TC_ECHO		9		/* Turn on echo			*/
 #define	TC_NOECHO	10		/* Turn off echo		*/
+#define	TC_IOVERRUN	11		/* Store chars dropped, buffer	*/
+					/*   full, in the uint16 at arg1*/
+					/*   (arg2 != 0 clears it)	*/
+#define	TC_HWOVERRUN	12		/* Store chars lost in the UART	*/
+					/*   in the uint16 at arg1	*/
+					/*   (arg2 != 0 clears it)	*/
+#define	TC_SPEED	13		/* Set the speed to arg1 bits/s	*/
+					/*   after sending what is	*/
+					/*   queued (kserial_getbaud()	*/
+					/*   returns the current one)	*/
@@ -67,6 +67,9 @@ void score_isr_logic(void){
 /* --- TAREA 1: LGICA DE JUEGO --- */
 void task_game_logic(void) {
     uint8_t last_level = 1;
+    struct periodic poll_period;
+
+    periodic_init(&poll_period, 20); // Sondeo cada 20 ms, sin deriva
 
     while(1) {
         switch(current_state) {
@@ -83,6 +86,7 @@ void task_game_logic(void) {
                     current_state = STATE_PLAYING;
                     update_display_flag = 1;
                     sleepms(100); 
+                    periodic_init(&poll_period, 20); // Pausa deliberada, no es overrun
 					anim_request = ANIM_LEVEL_1; // Arranca el bucle de servos nivel 1
                 }
                 break;
@@ -102,6 +106,7 @@ void task_game_logic(void) {
                         anim_request = ANIM_GAME_OVER;
                     }
                     sleepms(3000); 
+                    periodic_init(&poll_period, 20);
                 }
 
                 // Lgica de Niveles 
@@ -129,12 +134,13 @@ void task_game_logic(void) {
                      current_state = STATE_MENU;
                      update_display_flag = 1;
                      sleepms(500);
+                     periodic_init(&poll_period, 20);
                 }
                 break;
         }
         
-        // Ceder CPU
-        sleepms(20);
+        // Ceder CPU hasta la proxima liberacion del periodo
+        periodic_wait(&poll_period);
     }
 }
 
@@ -142,8 +148,10 @@ void task_game_logic(void) {
 void task_lcd_display(void) {
     char buffer[17]; // Buffer para linea LCD (16 chars + null)
     uint8_t last_known_state = 255; // Forzar update inicial
+    struct periodic refresh_period;
 
     lcd_clear();
+    periodic_init(&refresh_period, 100);
 
     while(1) {
         // Solo actualizamos si se levant la bandera o cambi el estado
@@ -185,7 +193,7 @@ void task_lcd_display(void) {
             update_display_flag = 0;
             last_known_state = current_state;
         }
-        sleepms(100);
+        periodic_wait(&refresh_period);
     }
 }
 
@@ -321,9 +329,16 @@ void sys_init(void) {
 		cmd = serial_get_char();
 		}
 	while(cmd != 'A');  // Bloqueante, espero a que llegue "A", que indica que el slave esta listo
+	serial_negotiate(SERIAL_LINKBAUD);  // Sube la velocidad del enlace si el slave la acepta
 	
 }
 
+/* --- TAREAS ESTATICAS --- */
+// Pila reservada en .bss; el kernel las crea (suspendidas) antes de main
+XINU_TASK(log, task_game_logic,  150, 20);
+XINU_TASK(ani, task_animator,    150, 15);
+XINU_TASK(lcd, task_lcd_display, 200, 10);
+
 /* --- MAIN --- */
 void main(void) {
     sys_init();
@@ -331,30 +346,9 @@ void main(void) {
 	// Habilitar interrupciones globales (necesario para INT0 y Timer1 PWM si usara ISR)
 	sei();
 	
-	pid32 pid_game  = create(task_game_logic,  150, 20, "log", 0);
-	pid32 pid_animator = create(task_animator, 150, 15, "ani", 0);
-	pid32 pid_lcd = create(task_lcd_display, 200, 10, "lcd", 0);
-
-	if (pid_game == SYSERR) {
-		//serial_put_str_flash(PSTR("Err:RAM Game\r\n"));
-		} else {
-		resume(pid_game);
-		//serial_put_str_flash(PSTR("Game OK\r\n"));
-	}
-
-	if (pid_animator == SYSERR) {
-		//serial_put_str_flash(PSTR("Err:RAM Anim\r\n"));
-		} else {
-		resume(pid_animator);
-		//serial_put_str_flash(PSTR("Anim OK\r\n"));
-	}
-
-	if (pid_lcd == SYSERR) {
-		//serial_put_str_flash(PSTR("Err:RAM LCD\r\n"));
-		} else {
-		resume(pid_lcd);
-		//serial_put_str_flash(PSTR("LCD OK\r\n"));
-	}
+	resume(XINU_TASKPID(log));
+	resume(XINU_TASKPID(ani));
+	resume(XINU_TASKPID(lcd));
 
     return;
 }
\ No newline at end of file
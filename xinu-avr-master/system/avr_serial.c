@@ -3,9 +3,9 @@
 #include <avr/interrupt.h>
 
 // #define F_CPU 4000000UL
-#define USART_BAUDRATE 9600
-#define BAUD_PRESCALE (((F_CPU/(USART_BAUDRATE*16UL)))-1)
 #define INIT 0x06
+#define U2X 0x02		/* ucsr0a: double speed, divides by 8	*/
+#define BAUD_MAXERR 50		/* reject rates more than 1/50 (2%) off	*/
 #define EN_RX_TX 0x18
 #define UART_RXCIE0 7 
 #define EN_TX 0x20
@@ -24,12 +24,74 @@ typedef struct {
 
 volatile uart_t *kserial_port = (uart_t *) (0xc0);
 
+local uint32 kserial_baud;	/* Current speed in bits/s		*/
+
+/*
+ * kserial_rate - Rate given by a divisor (ubrr + 1) in normal or U2X
+ * mode, and its distance to the requested one
+ */
+local uint32 kserial_rate(uint32 baud, uint32 div, uint32 clkdiv)
+{
+	uint32 rate = F_CPU / (clkdiv * div);
+
+	return (rate > baud) ? rate - baud : baud - rate;
+}
+
+/*
+ * kserial_setbaud - Set the speed of the UART.  Normal mode (clock/16)
+ * tolerates more receiver error, so it is used unless double speed
+ * (U2X, clock/8) gets closer to the rate asked for.  At 16 MHz 250000,
+ * 500000 and 1000000 are exact in normal mode, 2000000 needs U2X, and
+ * U2X brings 57600 from 2.1% to 0.8% off (115200 is 2.1% off either way).
+ * Returns SYSERR, leaving the speed alone, if no divisor is within 2%.
+ * The caller must make sure no character is being sent or received.
+ */
+status kserial_setbaud(uint32 baud)
+{
+	uint32 divn, div2;	/* Rounded divisors for normal and U2X	*/
+	uint32 errn, err2;	/* Distance of each rate to baud	*/
+
+	if (baud == 0 || baud > F_CPU / 8) {
+		return SYSERR;
+	}
+	divn = (F_CPU / 16 + baud / 2) / baud;
+	div2 = (F_CPU / 8 + baud / 2) / baud;
+	errn = (divn >= 1 && divn <= 4096) ? kserial_rate(baud, divn, 16)
+					   : 0xffffffffUL;
+	err2 = (div2 >= 1 && div2 <= 4096) ? kserial_rate(baud, div2, 8)
+					   : 0xffffffffUL;
+	if (errn <= err2) {
+		if (errn > baud / BAUD_MAXERR) {
+			return SYSERR;
+		}
+		kserial_port->status_control_a = 0;
+		div2 = divn;
+	} else {
+		if (err2 > baud / BAUD_MAXERR) {
+			return SYSERR;
+		}
+		kserial_port->status_control_a = U2X;
+	}
+	div2--;
+	kserial_port->baud_rate_h = (unsigned char) (div2 >> 8);
+	kserial_port->baud_rate_l = (unsigned char) (div2);
+	kserial_baud = baud;
+	return OK;
+}
+
+/*
+ * kserial_getbaud - Return the current speed of the UART in bits/s
+ */
+uint32 kserial_getbaud(void)
+{
+	return kserial_baud;
+}
+
 void kserial_init() 
 {
-	/* conf High and Low registers using BAUD_PRESCALE */
+	/* boot speed (CONSOLEBAUD in config/Configuration) */
 
-	kserial_port->baud_rate_h = (unsigned char) (BAUD_PRESCALE>>8);
-	kserial_port->baud_rate_l = (unsigned char) (BAUD_PRESCALE);
+	kserial_setbaud(CONSOLEBAUD);
 
 	/* 8bits frame, one parity bit and stop bit */
 	kserial_port->status_control_c = (unsigned char)(INIT);
@@ -41,23 +103,27 @@ void kserial_init()
 }
 
 
+/*
+ * Polled output for kprintf and the kernel's own streams.  The tty
+ * driver (device/tty) writes the same data register from its UDRE
+ * interrupt, so the test and the write are done with interrupts off;
+ * they are enabled again while waiting, so the tick is not held back.
+ */
 void kserial_put_char (char outputChar)
 {
-
-	while (!((kserial_port->status_control_a) & (EN_TX)));
-		kserial_port->data_es = outputChar;
+	intmask	mask;
+
+	while (TRUE) {
+		mask = disable();
+		if ((kserial_port->status_control_a) & (EN_TX)) {
+			kserial_port->data_es = outputChar;
+			restore(mask);
+			return;
+		}
+		restore(mask);
+	}
 }
 
-char value;
-
-/*
- * RX interrupt service rutine
- */
- ISR(USART_RX_vect){
- 	value = UDR0;             /* read UART register into value */
-//	// ttyhandler (1, value, 0);
- }
-
 char kserial_get_char(void)
 {
 	/* Wait for the next character to arrive. */
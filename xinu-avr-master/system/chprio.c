@@ -16,13 +16,18 @@ pri16	chprio(
 	pri16	oldprio;		/* Priority to return		*/
 
 	mask = disable();
-	if (isbadpid(pid)) {
+	if (isbadpid(pid) || isbadprio(newprio)) {
 		restore(mask);
 		return (pri16) SYSERR;
 	}
 	prptr = &proctab[pid];
 	oldprio = prptr->prprio;
+#if NMUTEX > 0
+	prptr->prbprio = newprio;	/* Mutexes may keep it higher	*/
+	prioupdate(pid);
+#else
 	prptr->prprio = newprio;
+#endif
 	restore(mask);
 	return oldprio;
 }
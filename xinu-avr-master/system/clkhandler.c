@@ -20,10 +20,38 @@ volatile unsigned int avr_ticks=0;
 ISR(TIMER2_COMPA_vect)
 {
 
+#if TICKLESS
+
+	/* Every clkperiod ms (1 ms unless the null process stretched	*/
+	/*   the tick while idle)					*/
+
+	clkticks += clkperiod;
+	traceclk(TR_ISRIN);
+	count1000 += clkperiod;
+	if(count1000 >= 1000) {
+		clktime++;
+		count1000 -= 1000;
+	}
+
+	if(!isempty(sleepq)) {
+		/* sleepq nonempty, subtract the elapsed time from the */
+		/* key of topmost process on sleepq                    */
+
+		if(queuetab[firstid(sleepq)].qkey <= clkperiod) {
+			queuetab[firstid(sleepq)].qkey = 0;
+			wakeup();
+		} else {
+			queuetab[firstid(sleepq)].qkey -= clkperiod;
+		}
+	}
+#else
+
 	/* Every ms */
 
-	/* Increment 1000ms counter */
+	/* Increment ms and 1000ms counters */
 
+	clkticks++;
+	traceclk(TR_ISRIN);
 	count1000++;
 
 	/* After 1 sec, increment clktime */
@@ -42,12 +70,28 @@ ISR(TIMER2_COMPA_vect)
 			wakeup();
 		}
 	}
+#endif
+
+#if SWTIMER
+	/* Wake the timer daemon if a software timer expired */
+
+	if (tmdue()) {
+		tmnotify();
+	}
+#endif
 
 	/* Decrement the preemption counter */
 	/* Reschedule if necessary          */
 	if((--preempt) == 0) {
 		preempt = QUANTUM;
-		resched();
+		isrresched = TRUE;
 	}
+
+	/* One reschedule for the quantum, the sleepers woken and the	*/
+	/*   timer daemon							*/
+
+	isr_exit();
+
+	traceclk(TR_ISROUT);
 }
 
@@ -0,0 +1,175 @@
+/* clkidle.c - clkstretch, clkidle, clkresume */
+
+/* avr specific */
+
+#include <xinu.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+#if TICKLESS
+
+/*
+ * While idle, TIMER2 runs with a prescaler 8 times slower than the
+ * normal 1 ms tick, so 125 timer counts are exactly 8 ms and one
+ * interrupt can stand for up to CLKMAXIDLE ms of elapsed time.
+ */
+
+#if ATMEGA
+#define	CLKCS_TICK	0b00000101	/* prescaler 128 (1 ms tick)	*/
+#define	CLKCS_IDLE	0b00000111	/* prescaler 1024		*/
+#else
+#define	CLKCS_TICK	0b00000011	/* prescaler 32 (1 ms tick)	*/
+#define	CLKCS_IDLE	0b00000110	/* prescaler 256		*/
+#endif
+
+#define	CLKOCR_TICK	125		/* compare value used by clkinit*/
+#define	CLKIDLESTEP	8		/* ms per 125 idle counts	*/
+#define	CLKMAXIDLE	16		/* longest idle period (ms)	*/
+
+uint16	clkperiod = 1;			/* ms per TIMER2 interrupt	*/
+local	byte	clkidlerem;		/* Short-tick counts the idle	*/
+					/*   TCNT2 is behind real time	*/
+local	uint32	clkidleticks;		/* clkticks when the current	*/
+					/*   idle period was programmed	*/
+
+/*------------------------------------------------------------------------
+ * clkstretch  -  Stretch the clock tick up to the first sleeper's wakeup,
+ *		    or go back to the 1 ms tick if that is too close
+ *------------------------------------------------------------------------
+ */
+local	void	clkstretch(void)	/* Assumes interrupts disabled	*/
+{
+	uint16	ms;			/* Time the CPU may stay idle	*/
+	byte	counts;			/* Counts into the current tick	*/
+#if SWTIMER
+	int32	left;			/* ms until the next timer	*/
+#endif
+
+	ms = isempty(sleepq) ? CLKMAXIDLE : firstkey(sleepq);
+#if SWTIMER
+	if (tmlist != NULL) {		/* Also wake for the next timer	*/
+		left = (int32)(tmlist->tmexpiry - clkticks);
+		if (left < (int32)ms) {
+			ms = (left > 0) ? left : 0;
+		}
+	}
+#endif
+	if (ms < CLKIDLESTEP || (TIFR2 & (1 << OCF2A))) {
+
+		/* Too short, or a 1 ms tick not yet counted: stay at	*/
+		/*   (or go back to) the 1 ms tick			*/
+
+		if (clkperiod != 1) {
+			clkresume();
+		}
+	} else {
+		if (ms > CLKMAXIDLE) {
+			ms = CLKMAXIDLE;
+		}
+		ms -= ms % CLKIDLESTEP;
+
+		if (clkperiod == 1) {
+
+			/* Carry the part of the current tick already	*/
+			/*   elapsed; the idle count is 8 times coarser,	*/
+			/*   so keep what it cannot hold for clkresume	*/
+
+			counts = TCNT2;
+			TCCR2B = CLKCS_IDLE;
+			TCNT2 = counts / CLKIDLESTEP;
+			clkidlerem = counts % CLKIDLESTEP;
+		}
+
+		/* An idle period that has ended restarted TCNT2 at 0	*/
+		/*   exactly on time: only the length of the next one	*/
+		/*   changes, so no time is lost between idle periods	*/
+
+		OCR2A = (ms / CLKIDLESTEP) * 125 - 1;
+		clkperiod = ms;
+		clkidleticks = clkticks;
+	}
+}
+
+/*------------------------------------------------------------------------
+ * clkidle  -  Called by the null process: stretch the clock tick up to
+ *		 the first sleeper's wakeup and put the CPU in idle sleep
+ *------------------------------------------------------------------------
+ */
+void	clkidle(void)			/* Assumes interrupts disabled	*/
+{
+	/* Woken by another interrupt before an idle period ended (the	*/
+	/*   clock handler has not counted it), the period still holds:	*/
+	/*   only a process can queue an earlier sleeper or timer, and	*/
+	/*   resched ends the idle period before one runs.  Touching	*/
+	/*   TIMER2 then would lose the part of a count already elapsed	*/
+
+	if (clkperiod == 1 || clkticks != clkidleticks) {
+		clkstretch();
+	}
+
+	/* Sleep until the next interrupt; sei lets exactly one more	*/
+	/*   instruction run, so no wakeup can be lost in between	*/
+
+	set_sleep_mode(SLEEP_MODE_IDLE);
+	sleep_enable();
+	sei();
+	sleep_cpu();
+	sleep_disable();
+	cli();
+}
+
+/*------------------------------------------------------------------------
+ * clkresume  -  Return TIMER2 to the 1 ms tick, accounting for the part
+ *		   of a stretched idle period that has already elapsed
+ *------------------------------------------------------------------------
+ */
+void	clkresume(void)			/* Assumes interrupts disabled	*/
+{
+	uint16	counts;			/* Short-tick counts elapsed	*/
+	uint16	ms;			/* Whole ms elapsed		*/
+
+	if (TIFR2 & (1 << OCF2A)) {
+
+		/* The period expired but its interrupt is still	*/
+		/*   pending: account all but the last ms here and	*/
+		/*   leave the pending interrupt to count that one	*/
+
+		ms = clkperiod - 1;
+		counts = (uint16)TCNT2 * CLKIDLESTEP + clkidlerem;
+		if (counts >= 125) {
+			counts = 124;
+		}
+	} else {
+		counts = (uint16)TCNT2 * CLKIDLESTEP + clkidlerem;
+		ms = counts / 125;
+		counts -= ms * 125;
+	}
+
+	TCCR2B = CLKCS_TICK;
+	OCR2A = CLKOCR_TICK;
+	TCNT2 = counts;
+	clkperiod = 1;
+
+	/* Catch up the clocks and the first sleeper; ms is less	*/
+	/*   than the first key unless the null process got here late	*/
+	/*   (a long interrupt handler), and then the sleeper is left	*/
+	/*   for the next tick to wake					*/
+
+	clkticks += ms;
+	count1000 += ms;
+	while (count1000 >= 1000) {
+		clktime++;
+		count1000 -= 1000;
+	}
+	if (nonempty(sleepq)) {
+		if (queuetab[firstid(sleepq)].qkey > ms) {
+			queuetab[firstid(sleepq)].qkey -= ms;
+		} else {
+			queuetab[firstid(sleepq)].qkey = 1;
+		}
+	}
+}
+
+#endif
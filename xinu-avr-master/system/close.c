@@ -21,7 +21,7 @@ syscall	close(
 		return SYSERR;
 	}
 	devptr = (struct dentry *) &devtab[descrp];
-	retval = (*devptr->dvclose) (devptr);
+	retval = (*devptr->dvclose) ((struct dentry *) devptr);
 	restore(mask);
 	return retval;
 }
@@ -24,7 +24,7 @@ syscall	control(
 		return SYSERR;
 	}
 	devptr = (struct dentry *) &devtab[descrp];
-	retval = (*devptr->dvcntl) (devptr, func, arg1, arg2);
+	retval = (*devptr->dvcntl) ((struct dentry *) devptr, func, arg1, arg2);
 	restore(mask);
 	return retval;
 }
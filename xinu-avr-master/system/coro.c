@@ -0,0 +1,123 @@
+/* coro.c - costart, corun, cosignal, cosignal_isr, coclear */
+
+#include <xinu.h>
+
+/*------------------------------------------------------------------------
+ *  costart  -  Add a coroutine to the set run by corun()
+ *------------------------------------------------------------------------
+ */
+syscall	costart(
+	  struct cosched *cs,		/* Coroutine set		*/
+	  struct coro	*co,		/* Caller-owned coroutine	*/
+	  char		(*func)(struct coro *) /* Coroutine function	*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+
+	if (func == NULL) {
+		return SYSERR;
+	}
+	mask = disable();
+	co->cofunc = func;
+	co->colc = 0;
+	co->cosleep = FALSE;
+	co->coevents = 0;
+	co->copid = currpid;
+	co->conext = cs->cohead;
+	cs->cohead = co;
+	restore(mask);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  corun  -  Run a set of coroutines in the calling process until all
+ *		of them have ended
+ *------------------------------------------------------------------------
+ */
+void	corun(
+	  struct cosched *cs		/* Coroutine set		*/
+	)
+{
+	struct	coro	*co;		/* Coroutine being run		*/
+	struct	coro	**prev;		/* Link to co in the set	*/
+	bool8	ran;			/* Some coroutine yielded	*/
+	int32	nap;			/* ms to wait when none can run	*/
+	int32	left;			/* ms left of a CO_SLEEP	*/
+	char	ret;			/* Value returned by a coroutine*/
+
+	while (cs->cohead != NULL) {
+		ran = FALSE;
+		nap = COPOLLMS;
+		prev = &cs->cohead;
+		while ((co = *prev) != NULL) {
+			co->copid = currpid;
+			ret = co->cofunc(co);
+			if (ret >= CO_EXITED) {	/* Unlink finished ones	*/
+				*prev = co->conext;
+				continue;
+			}
+			if (ret == CO_YIELDED) {
+				ran = TRUE;
+			} else if (co->cosleep) {
+				left = (int32)(co->cowake - getticks());
+				if (left < nap) {
+					nap = (left > 0) ? left : 0;
+				}
+			}
+			prev = &co->conext;
+		}
+
+		/* Wait when every coroutine is blocked */
+
+		if (!ran && nap > 0) {
+			notifywait(CONOTE, nap);
+		}
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  cosignal  -  Post event bits to a coroutine and wake its process
+ *------------------------------------------------------------------------
+ */
+syscall	cosignal(
+	  struct coro	*co,		/* Coroutine to signal		*/
+	  byte		bits		/* Event bits to set		*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+
+	mask = disable();
+	co->coevents |= bits;
+	restore(mask);
+	return notify(co->copid, CONOTE);
+}
+
+/*------------------------------------------------------------------------
+ *  cosignal_isr  -  Post event bits to a coroutine from an interrupt
+ *		       handler (the handler ends with isr_exit)
+ *------------------------------------------------------------------------
+ */
+syscall	cosignal_isr(			/* Assumes interrupts disabled	*/
+	  struct coro	*co,		/* Coroutine to signal		*/
+	  byte		bits		/* Event bits to set		*/
+	)
+{
+	co->coevents |= bits;
+	return notify_isr(co->copid, CONOTE);
+}
+
+/*------------------------------------------------------------------------
+ *  coclear  -  Clear event bits of a coroutine (used by CO_WAIT_EVENT)
+ *------------------------------------------------------------------------
+ */
+void	coclear(
+	  struct coro	*co,		/* Coroutine			*/
+	  byte		bits		/* Event bits to clear		*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+
+	mask = disable();
+	co->coevents &= ~bits;
+	restore(mask);
+}
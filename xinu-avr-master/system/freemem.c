@@ -14,8 +14,22 @@ syscall	freemem(
 	intmask	mask;			/* Saved interrupt mask		*/
 	struct	memblk	*next, *prev, *block;
 	uint32	top;
+#if NMPOOL > 0
+	syscall	retval;			/* Value returned by mpfree	*/
+#endif
 
 	mask = disable();
+
+#if NMPOOL > 0
+	/* Blocks inside a pool arena go back to their class; any other	*/
+	/*   address inside an arena is an error, not a heap block	*/
+
+	if ((retval = mpfree(blkaddr)) != MPNOTPOOL) {
+		restore(mask);
+		return retval;
+	}
+#endif
+
 	if ((nbytes == 0) || ((uint32) blkaddr < (uint32) minheap)
 			  || ((uint32) blkaddr > (uint32) maxheap)) {
 		restore(mask);
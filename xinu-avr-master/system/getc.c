@@ -21,7 +21,7 @@ syscall	getc(
 		return SYSERR;
 	}
 	devptr = (struct dentry *) &devtab[descrp];
-	retval = (*devptr->dvgetc) (devptr);
+	retval = (*devptr->dvgetc) ((struct dentry *) devptr);
 	restore(mask);
 	return retval;
 }
@@ -12,6 +12,9 @@ char  	*getmem(
 {
 	intmask	mask;			/* Saved interrupt mask		*/
 	struct	memblk	*prev, *curr, *leftover;
+#if NMPOOL > 0
+	char	*blk;			/* Block from a fixed-size pool	*/
+#endif
 
 	mask = disable();
 	if (nbytes == 0) {
@@ -19,6 +22,15 @@ char  	*getmem(
 		return (char *)SYSERR;
 	}
 
+#if NMPOOL > 0
+	/* Use a fixed-size pool block if a class fits */
+
+	if ((blk = mpget(nbytes)) != (char *)SYSERR) {
+		restore(mask);
+		return blk;
+	}
+#endif
+
 	nbytes = (uint32) roundmb(nbytes);	/* Use memblk multiples	*/
 
 	prev = &memlist;
@@ -13,6 +13,9 @@ char  	*getstk(
 	intmask	mask;			/* Saved interrupt mask		*/
 	struct	memblk	*prev, *curr;	/* Walk through memory list	*/
 	struct	memblk	*fits, *fitsprev; /* Record block that fits	*/
+#if NMPOOL > 0
+	char	*blk;			/* Block from a fixed-size pool	*/
+#endif
 
 	mask = disable();
 	if (nbytes == 0) {
@@ -22,6 +25,16 @@ char  	*getstk(
 
 	nbytes = (uint32) roundmb(nbytes);	/* Use mblock multiples	*/
 
+#if NMPOOL > 0
+	/* Use a fixed-size pool block if a class fits; freestk finds	*/
+	/*   the start of the block again from nbytes			*/
+
+	if ((blk = mpget(nbytes)) != (char *)SYSERR) {
+		restore(mask);
+		return blk + nbytes - sizeof(uint32);
+	}
+#endif
+
 	prev = &memlist;
 	curr = memlist.mnext;
 	fits = NULL;
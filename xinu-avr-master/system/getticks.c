@@ -1,14 +1,59 @@
-/* getticks.c - getticks */
+/* getticks.c - getticks, getmicros */
 
 #include <xinu.h>
 
+/* avr specific */
+#include <avr/io.h>
+
+#define	CLKUSPERCNT	8	/* us per TIMER2 count at the 1 ms tick	*/
+
 /*------------------------------------------------------------------------
- *  getticks  -  Retrieve the number of clock ticks since CPU reset
+ *  getticks  -  Retrieve the number of clock ticks (ms) since CPU reset
  *------------------------------------------------------------------------
  */
 uint32  	getticks()
 {
-	/* Cortex M3 does have a clock cycle cnt register */
-	uint32 ret = 0;
+	intmask	mask;			/* Saved interrupt mask		*/
+	uint32	ret;			/* Tick count to return		*/
+
+	mask = disable();		/* 32-bit read is not atomic	*/
+	ret = clkticks;
+	restore(mask);
 	return ret;
 }
+
+/*------------------------------------------------------------------------
+ *  getmicros  -  Retrieve the number of microseconds since CPU reset,
+ *		    interpolated from TIMER2 (wraps after ~71 minutes)
+ *------------------------------------------------------------------------
+ */
+uint32	getmicros()
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	uint32	ms;			/* Whole ms counted so far	*/
+	uint16	counts;			/* Timer counts into this tick	*/
+	uint16	uspercnt;		/* us represented by one count	*/
+
+	mask = disable();
+	ms = clkticks;
+	counts = TCNT2;
+#if TICKLESS
+	uspercnt = CLKUSPERCNT * (clkperiod == 1 ? 1 : 8);
+#else
+	uspercnt = CLKUSPERCNT;
+#endif
+
+	/* A compare match whose interrupt is still pending has	*/
+	/*   restarted TCNT2 without updating clkticks yet		*/
+
+	if (TIFR2 & (1 << OCF2A)) {
+		counts = TCNT2;
+#if TICKLESS
+		ms += clkperiod;
+#else
+		ms++;
+#endif
+	}
+	restore(mask);
+	return ms * 1000 + (uint32)counts * uspercnt;
+}
@@ -0,0 +1,149 @@
+/* mqueue.c - mq_init, mq_send, mq_send_isr, mq_recv, mq_recv_timeout */
+
+#include <xinu.h>
+
+/*------------------------------------------------------------------------
+ *  mq_init  -  Create the semaphores of a statically defined queue
+ *------------------------------------------------------------------------
+ */
+status	mq_init(
+	  struct mqueue	*mq		/* Queue from MQ_DEFINE		*/
+	)
+{
+	if (mq->mqsize == 0 || mq->mqdepth == 0) {
+		return SYSERR;
+	}
+	mq->mqhead = mq->mqcount = mq->mqmax = 0;
+	mq->mqfull = 0;
+	if ((mq->mqitems = semcreate(0)) == SYSERR) {
+		return SYSERR;
+	}
+	if ((mq->mqspaces = semcreate(mq->mqdepth)) == SYSERR) {
+		semdelete(mq->mqitems);
+		return SYSERR;
+	}
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  mqput  -  Copy a message into the slot after the newest one
+ *------------------------------------------------------------------------
+ */
+local	void	mqput(			/* Assumes interrupts disabled	*/
+	  struct mqueue	*mq,		/* Queue with a free slot	*/
+	  const void	*msg		/* Message to copy		*/
+	)
+{
+	byte	slot;			/* Slot to fill			*/
+
+	slot = mq->mqhead + mq->mqcount;
+	if (slot >= mq->mqdepth) {
+		slot -= mq->mqdepth;
+	}
+	memcpy(mq->mqbuf + slot * mq->mqsize, msg, mq->mqsize);
+	if (++mq->mqcount > mq->mqmax) {
+		mq->mqmax = mq->mqcount;
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  mqget  -  Copy out and remove the oldest message
+ *------------------------------------------------------------------------
+ */
+local	void	mqget(			/* Assumes interrupts disabled	*/
+	  struct mqueue	*mq,		/* Queue holding a message	*/
+	  void		*msg		/* Buffer for the message	*/
+	)
+{
+	memcpy(msg, mq->mqbuf + mq->mqhead * mq->mqsize, mq->mqsize);
+	if (++mq->mqhead >= mq->mqdepth) {
+		mq->mqhead = 0;
+	}
+	mq->mqcount--;
+}
+
+/*------------------------------------------------------------------------
+ *  mq_send  -  Queue a copy of a message, waiting while the queue is full
+ *------------------------------------------------------------------------
+ */
+syscall	mq_send(
+	  struct mqueue	*mq,		/* Queue to send on		*/
+	  const void	*msg		/* Message of mq->mqsize bytes	*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+
+	if (wait(mq->mqspaces) == SYSERR) {
+		return SYSERR;
+	}
+	mask = disable();
+	mqput(mq, msg);
+	signal(mq->mqitems);
+	restore(mask);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  mq_send_isr  -  Queue a message from an interrupt handler; fails if
+ *		      the queue is full (the handler ends with isr_exit)
+ *------------------------------------------------------------------------
+ */
+syscall	mq_send_isr(			/* Assumes interrupts disabled	*/
+	  struct mqueue	*mq,		/* Queue to send on		*/
+	  const void	*msg		/* Message of mq->mqsize bytes	*/
+	)
+{
+	if (semtab[mq->mqspaces].scount <= 0) {
+		mq->mqfull++;
+		return SYSERR;
+	}
+	semtab[mq->mqspaces].scount--;	/* Take a slot without waiting	*/
+	mqput(mq, msg);
+	return signal_isr(mq->mqitems);
+}
+
+/*------------------------------------------------------------------------
+ *  mq_recv  -  Remove the oldest message, waiting while the queue is
+ *		  empty
+ *------------------------------------------------------------------------
+ */
+syscall	mq_recv(
+	  struct mqueue	*mq,		/* Queue to receive from	*/
+	  void		*msg		/* Buffer of mq->mqsize bytes	*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+
+	if (wait(mq->mqitems) == SYSERR) {
+		return SYSERR;
+	}
+	mask = disable();
+	mqget(mq, msg);
+	signal(mq->mqspaces);
+	restore(mask);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  mq_recv_timeout  -  Remove the oldest message, waiting at most maxwait
+ *			  ms for one; returns OK, TIMEOUT or SYSERR
+ *------------------------------------------------------------------------
+ */
+syscall	mq_recv_timeout(
+	  struct mqueue	*mq,		/* Queue to receive from	*/
+	  void		*msg,		/* Buffer of mq->mqsize bytes	*/
+	  int32		maxwait		/* Max wait in ms (0 = poll)	*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	syscall	retval;
+
+	if ((retval = waittime(mq->mqitems, maxwait)) != OK) {
+		return retval;
+	}
+	mask = disable();
+	mqget(mq, msg);
+	signal(mq->mqspaces);
+	restore(mask);
+	return OK;
+}
@@ -0,0 +1,274 @@
+/* mutex.c - mutinit, mutcreate, mutdelete, mutlock, mutunlock, mutkill,
+ *	     mutprio, prioupdate
+ */
+
+#include <xinu.h>
+
+#if NMUTEX > 0
+
+struct	mutent	mutab[NMUTEX];		/* Mutex table			*/
+
+/*------------------------------------------------------------------------
+ *  mutinit  -  Initialize the mutex table
+ *------------------------------------------------------------------------
+ */
+void	mutinit(void)
+{
+	int32	i;
+
+	for (i = 0; i < NMUTEX; i++) {
+		mutab[i].mustate = MU_FREE;
+		mutab[i].muowner = EMPTY;
+		mutab[i].muqueue = newqueue();
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  mutcreate  -  Create a mutex, optionally with a ceiling priority
+ *------------------------------------------------------------------------
+ */
+mid16	mutcreate(
+	  pri16		ceiling		/* Ceiling priority or MUNOCEIL	*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	mid16	mid;			/* Mutex ID to return		*/
+
+	mask = disable();
+	if (ceiling < 0 || isbadprio(ceiling)) {
+		restore(mask);
+		return SYSERR;
+	}
+	for (mid = 0; mid < NMUTEX; mid++) {
+		if (mutab[mid].mustate == MU_FREE) {
+			mutab[mid].mustate = MU_USED;
+			mutab[mid].muowner = EMPTY;
+			mutab[mid].muceil = ceiling;
+			restore(mask);
+			return mid;
+		}
+	}
+	restore(mask);
+	return SYSERR;
+}
+
+/*------------------------------------------------------------------------
+ *  mutdelete  -  Delete a mutex; waiting processes return SYSERR
+ *------------------------------------------------------------------------
+ */
+syscall	mutdelete(
+	  mid16		mid		/* ID of mutex to delete	*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	struct	mutent	*muptr;		/* Ptr to mutex table entry	*/
+	pid32	pid;
+
+	mask = disable();
+	if (isbadmut(mid) || mutab[mid].mustate == MU_FREE) {
+		restore(mask);
+		return SYSERR;
+	}
+	muptr = &mutab[mid];
+	muptr->mustate = MU_FREE;
+
+	resched_cntl(DEFER_START);
+	if (muptr->muowner != EMPTY) {	/* Owner loses what it inherited*/
+		prioupdate(muptr->muowner);
+		muptr->muowner = EMPTY;
+	}
+	while ((pid = getfirst(muptr->muqueue)) != EMPTY) {
+		ready(pid);
+	}
+	resched_cntl(DEFER_STOP);
+	restore(mask);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  mutlock  -  Acquire a mutex, lending the caller's priority to the
+ *		  owner while blocked
+ *------------------------------------------------------------------------
+ */
+syscall	mutlock(
+	  mid16		mid		/* ID of mutex to lock		*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	struct	mutent	*muptr;		/* Ptr to mutex table entry	*/
+	struct	procent	*prptr;		/* Ptr to caller's table entry	*/
+	syscall	retval;
+
+	mask = disable();
+	if (isbadmut(mid) || mutab[mid].mustate == MU_FREE
+	    || mutab[mid].muowner == currpid) {
+		restore(mask);
+		return SYSERR;
+	}
+	muptr = &mutab[mid];
+
+	if (muptr->muowner == EMPTY) {	/* Free: take it at once	*/
+		muptr->muowner = currpid;
+		prioupdate(currpid);	/* Apply the ceiling, if any	*/
+		restore(mask);
+		return OK;
+	}
+
+	/* Queue by priority and raise the owner (and whatever it	*/
+	/*   is blocked on in turn) to at least the caller's priority	*/
+
+	prptr = &proctab[currpid];
+	prptr->prstate = PR_MUTEX;
+	prptr->prmutex = mid;
+	insert(currpid, muptr->muqueue, prptr->prprio);
+	prioupdate(muptr->muowner);
+	resched();
+
+	/* mutunlock() makes the caller the owner; mutdelete does not	*/
+
+	retval = (muptr->muowner == currpid) ? OK : SYSERR;
+	restore(mask);
+	return retval;
+}
+
+/*------------------------------------------------------------------------
+ *  mutpass  -  Hand a mutex to its highest priority waiter, if any, and
+ *		  return the new owner (EMPTY if the mutex is now free)
+ *------------------------------------------------------------------------
+ */
+local	pid32	mutpass(		/* Assumes interrupts disabled	*/
+	  mid16		mid		/* ID of an owned mutex		*/
+	)
+{
+	struct	mutent	*muptr;		/* Ptr to mutex table entry	*/
+	pid32	pid;			/* New owner			*/
+
+	muptr = &mutab[mid];
+	if (isempty(muptr->muqueue)) {
+		muptr->muowner = EMPTY;
+		return EMPTY;
+	}
+	pid = dequeue(muptr->muqueue);
+	muptr->muowner = pid;
+	proctab[pid].prprio = mutprio(pid);
+	return pid;
+}
+
+/*------------------------------------------------------------------------
+ *  mutunlock  -  Release a mutex held by the caller and drop any
+ *		    priority it inherited through the mutex
+ *------------------------------------------------------------------------
+ */
+syscall	mutunlock(
+	  mid16		mid		/* ID of mutex to unlock	*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	pid32	pid;			/* Next owner			*/
+
+	mask = disable();
+	if (isbadmut(mid) || mutab[mid].mustate == MU_FREE
+	    || mutab[mid].muowner != currpid) {
+		restore(mask);
+		return SYSERR;
+	}
+	pid = mutpass(mid);
+	prioupdate(currpid);
+	if (pid != EMPTY) {
+		ready(pid);
+	} else {
+		resched();
+	}
+	restore(mask);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  mutkill  -  Release every mutex held by a process being killed
+ *------------------------------------------------------------------------
+ */
+void	mutkill(			/* Assumes interrupts disabled	*/
+	  pid32		pid		/* ID of process being killed	*/
+	)
+{
+	mid16	mid;
+	pid32	next;			/* Next owner			*/
+
+	resched_cntl(DEFER_START);
+	for (mid = 0; mid < NMUTEX; mid++) {
+		if (mutab[mid].mustate == MU_USED
+		    && mutab[mid].muowner == pid) {
+			if ((next = mutpass(mid)) != EMPTY) {
+				ready(next);
+			}
+		}
+	}
+	resched_cntl(DEFER_STOP);
+}
+
+/*------------------------------------------------------------------------
+ *  mutprio  -  Return the priority a process should run at: its base
+ *		  priority raised to the ceiling and first waiter of each
+ *		  mutex it holds
+ *------------------------------------------------------------------------
+ */
+pri16	mutprio(			/* Assumes interrupts disabled	*/
+	  pid32		pid		/* ID of process		*/
+	)
+{
+	struct	mutent	*muptr;		/* Ptr to mutex table entry	*/
+	pri16	prio;			/* Effective priority		*/
+	mid16	mid;
+
+	prio = proctab[pid].prbprio;
+	for (mid = 0; mid < NMUTEX; mid++) {
+		muptr = &mutab[mid];
+		if (muptr->mustate == MU_FREE || muptr->muowner != pid) {
+			continue;
+		}
+		if (muptr->muceil > prio) {
+			prio = muptr->muceil;
+		}
+		if (nonempty(muptr->muqueue)
+		    && (pri16)firstkey(muptr->muqueue) > prio) {
+			prio = firstkey(muptr->muqueue);
+		}
+	}
+	return prio;
+}
+
+/*------------------------------------------------------------------------
+ *  prioupdate  -  Recompute a process's effective priority and move it
+ *		     in the list it is on; a process blocked on a mutex
+ *		     passes the change on to that mutex's owner
+ *------------------------------------------------------------------------
+ */
+void	prioupdate(			/* Assumes interrupts disabled	*/
+	  pid32		pid		/* ID of process		*/
+	)
+{
+	struct	procent	*prptr;		/* Ptr to process's table entry	*/
+	pri16	prio;			/* New effective priority	*/
+
+	prptr = &proctab[pid];
+	prio = mutprio(pid);
+	if (prio == prptr->prprio) {
+		return;
+	}
+	prptr->prprio = prio;
+
+	switch (prptr->prstate) {
+	case PR_READY:
+		rdyremove(pid);
+		rdyinsert(pid, prio);
+		break;
+
+	case PR_MUTEX:
+		getitem(pid);
+		insert(pid, mutab[prptr->prmutex].muqueue, prio);
+		prioupdate(mutab[prptr->prmutex].muowner);
+		break;
+	}
+}
+
+#endif
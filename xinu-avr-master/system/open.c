@@ -22,7 +22,7 @@ syscall	open(
 		return SYSERR;
 	}
 	devptr = (struct dentry *) &devtab[descrp];
-	retval = (*devptr->dvopen) (devptr, name, mode);
+	retval = (*devptr->dvopen) ((struct dentry *) devptr, name, mode);
 	restore(mask);
 	return retval;
 }
@@ -0,0 +1,82 @@
+/* periodic.c - periodic_init, periodic_wait, getoverrun */
+
+#include <xinu.h>
+
+/*------------------------------------------------------------------------
+ *  periodic_init  -  Start a periodic release sequence one period from
+ *			now (also used to re-arm after a deliberate pause)
+ *------------------------------------------------------------------------
+ */
+syscall	periodic_init(
+	  struct periodic *pp,		/* Handle to initialize		*/
+	  uint16	period		/* Period in ms			*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+
+	if (period == 0) {
+		return SYSERR;
+	}
+	mask = disable();
+	pp->pperiod = period;
+	pp->pnext = clkticks + period;
+	restore(mask);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  periodic_wait  -  Block until the next release of a periodic task;
+ *			a release that has already passed is counted as
+ *			an overrun and the task waits for the next one,
+ *			while one due on this very tick is still on time
+ *------------------------------------------------------------------------
+ */
+syscall	periodic_wait(
+	  struct periodic *pp		/* Handle of the calling task	*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	uint32	release;		/* Release time to wait for	*/
+	uint32	late;			/* ms past the missed release	*/
+	syscall	retval;			/* Value returned by sleepuntil	*/
+
+	mask = disable();
+	release = pp->pnext;
+	if ((int32)(release - clkticks) < 0) {
+
+		/* Deadline missed: skip the releases that already	*/
+		/*   passed, keeping the original phase			*/
+
+		late = clkticks - release;
+		release += (late / pp->pperiod + 1) * pp->pperiod;
+		if (proctab[currpid].proverrun < 0xffff) {
+			proctab[currpid].proverrun++;
+		}
+	}
+	pp->pnext = release + pp->pperiod;
+	retval = sleepuntil(release);
+	restore(mask);
+	return retval;
+}
+
+/*------------------------------------------------------------------------
+ *  getoverrun  -  Return the number of periodic deadlines a process has
+ *		     missed
+ *------------------------------------------------------------------------
+ */
+uint16	getoverrun(
+	  pid32		pid		/* Process ID			*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	uint16	count;			/* Overrun count to return	*/
+
+	mask = disable();
+	if (isbadpid(pid)) {
+		restore(mask);
+		return (uint16)SYSERR;
+	}
+	count = proctab[pid].proverrun;
+	restore(mask);
+	return count;
+}
@@ -22,7 +22,7 @@ syscall	read(
 		return SYSERR;
 	}
 	devptr = (struct dentry *) &devtab[descrp];
-	retval = (*devptr->dvread) (devptr, buffer, count);
+	retval = (*devptr->dvread) ((struct dentry *) devptr, buffer, count);
 	restore(mask);
 	return retval;
 }
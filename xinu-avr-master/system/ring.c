@@ -0,0 +1,78 @@
+/* ring.c - ringinit, ringwait, ringwake, ringwake_isr */
+
+#include <xinu.h>
+
+/*------------------------------------------------------------------------
+ *  ringinit  -  Initialize the header of a ring made with RING_DEFINE,
+ *		   creating a semaphore only if the consumer will block
+ *------------------------------------------------------------------------
+ */
+status	ringinit(
+	  struct ringhdr *rh,		/* Header of the ring		*/
+	  bool8		blocking	/* Whether name_getw is used	*/
+	)
+{
+	rh->rhead = 0;
+	rh->rtail = 0;
+	rh->rwait = FALSE;
+	rh->rsem = SYSERR;
+	if (blocking && (rh->rsem = semcreate(0)) == SYSERR) {
+		return SYSERR;
+	}
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  ringwait  -  Block the consumer until the ring is not empty
+ *------------------------------------------------------------------------
+ */
+void	ringwait(
+	  struct ringhdr *rh		/* Header of the ring		*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+
+	/* Check again with interrupts off so a put cannot slip in	*/
+	/*   between the test and setting rwait			*/
+
+	mask = disable();
+	if (rh->rhead == rh->rtail && rh->rsem != SYSERR) {
+		rh->rwait = TRUE;
+		wait(rh->rsem);
+	}
+	restore(mask);
+}
+
+/*------------------------------------------------------------------------
+ *  ringwake  -  Called by a producer process after a put when the
+ *		   consumer is blocked: release it
+ *------------------------------------------------------------------------
+ */
+void	ringwake(
+	  struct ringhdr *rh		/* Header of the ring		*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+
+	mask = disable();
+	if (rh->rwait) {
+		rh->rwait = FALSE;
+		signal(rh->rsem);
+	}
+	restore(mask);
+}
+
+/*------------------------------------------------------------------------
+ *  ringwake_isr  -  Same as ringwake for a producer that is an interrupt
+ *		       handler, which must end with isr_exit()
+ *------------------------------------------------------------------------
+ */
+void	ringwake_isr(			/* Assumes interrupts disabled	*/
+	  struct ringhdr *rh		/* Header of the ring		*/
+	)
+{
+	if (rh->rwait) {
+		rh->rwait = FALSE;
+		signal_isr(rh->rsem);
+	}
+}
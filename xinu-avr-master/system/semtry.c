@@ -0,0 +1,30 @@
+/* semtry.c - semtry */
+
+#include <xinu.h>
+
+/*------------------------------------------------------------------------
+ *  semtry  -  Take a semaphore only if that does not block: return OK
+ *		 if the count was positive (and decrement it), else SYSERR
+ *------------------------------------------------------------------------
+ */
+syscall	semtry(
+	  sid32		sem		/* ID of semaphore to take	*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	struct	sentry *semptr;		/* Ptr to sempahore table entry	*/
+
+	mask = disable();
+	if (isbadsem(sem)) {
+		restore(mask);
+		return SYSERR;
+	}
+	semptr = &semtab[sem];
+	if (semptr->sstate == S_FREE || semptr->scount <= 0) {
+		restore(mask);
+		return SYSERR;
+	}
+	semptr->scount--;
+	restore(mask);
+	return OK;
+}
@@ -23,8 +23,9 @@ syscall	signal(
 		restore(mask);
 		return SYSERR;
 	}
+	trace(TR_SIGNAL, sem);
 	if ((semptr->scount++) < 0) {	/* Release a waiting process */
-		ready(dequeue(semptr->squeue));
+		ready(semdequeue(sem));
 	}
 	restore(mask);
 	return OK;
@@ -28,7 +28,7 @@ syscall	suspend(
 		return SYSERR;
 	}
 	if (prptr->prstate == PR_READY) {
-		getitem(pid);		    /* Remove a ready process	*/
+		rdyremove(pid);		    /* Remove a ready process	*/
 					    /*   from the ready list	*/
 		prptr->prstate = PR_SUSP;
 	} else {
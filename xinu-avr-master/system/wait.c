@@ -26,10 +26,13 @@ syscall	wait(
 		return SYSERR;
 	}
 
+	trace(TR_WAIT, sem);
+
 	if (--(semptr->scount) < 0) {		/* If caller must block	*/
 		prptr = &proctab[currpid];
 		prptr->prstate = PR_WAIT;	/* Set state to waiting	*/
 		prptr->prsem = sem;		/* Record semaphore ID	*/
+		prptr->prwseq = semptr->sseq++;	/* Place among waiters	*/
 		enqueue(currpid,semptr->squeue);/* Enqueue on semaphore	*/
 		resched();			/*   and reschedule	*/
 	}
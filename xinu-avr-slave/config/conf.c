@@ -19,15 +19,15 @@ const __flash struct	dentry	devtab[] =
  * dev-csr-address, intr-handler, irq
  */
 
-/* CONSOLE is null */
+/* CONSOLE is tty */
 	{ 0, 0, "CONSOLE",
-	  (void *)ionull, (void *)ionull, (void *)ionull,
-	  (void *)ionull, (void *)ionull, (void *)ioerr,
-	  (void *)ionull, (void *)ionull, (void *)ioerr,
-	  (void *)0x0, (void *)ioerr, 0 },
+	  (void *)ttyinit, (void *)ionull, (void *)ionull,
+	  (void *)ttyread, (void *)ttywrite, (void *)ioerr,
+	  (void *)ttygetc, (void *)ttyputc, (void *)ttycontrol,
+	  (void *)0xc0, (void *)ionull, 0 },
 
 /* NULLDEV is null */
-	{ 1, 1, "NULLDEV",
+	{ 1, 0, "NULLDEV",
 	  (void *)ionull, (void *)ionull, (void *)ionull,
 	  (void *)ionull, (void *)ionull, (void *)ioerr,
 	  (void *)ionull, (void *)ionull, (void *)ioerr,
@@ -0,0 +1,110 @@
+/* ttycontrol.c - ttycontrol */
+
+#include <xinu.h>
+
+/*------------------------------------------------------------------------
+ *  ttycontrol  -  Control a tty device by setting modes and speed or
+ *		     reading its overrun counters
+ *------------------------------------------------------------------------
+ */
+devcall	ttycontrol(
+	  const __flash struct dentry *devptr,	/* Entry in device switch table	*/
+	  int32	 func,			/* Function to perform		*/
+	  int32	 arg1,			/* Argument 1 for request	*/
+	  int32	 arg2			/* Argument 2 for request	*/
+	)
+{
+	struct	ttycblk	*typtr;		/* Pointer to tty control block	*/
+	intmask	mask;			/* Saved interrupt mask		*/
+	char	ch;			/* Character for lookahead	*/
+
+	typtr = &ttytab[devptr->dvminor];
+
+	/* Process the request */
+
+	switch ( func )	{
+
+	case TC_NEXTC:
+		wait(typtr->tyisem);
+		ch = typtr->tyibuff[typtr->tyihead & (TY_IBUFLEN - 1)];
+		signal(typtr->tyisem);
+		return (devcall)(byte)ch;
+
+	case TC_MODER:
+		typtr->tyimode = TY_IMRAW;
+		typtr->tyiecho = FALSE;
+		typtr->tyicrlf = FALSE;
+		typtr->tyocrlf = FALSE;
+		return (devcall)OK;
+
+	case TC_MODEK:
+		typtr->tyimode = TY_IMCBREAK;
+		typtr->tyiecho = TRUE;
+		typtr->tyicrlf = TRUE;
+		typtr->tyocrlf = TRUE;
+		return (devcall)OK;
+
+	case TC_ICHARS:
+		return (byte)(typtr->tyitail - typtr->tyihead);
+
+	case TC_ECHO:
+		typtr->tyiecho = TRUE;
+		return (devcall)OK;
+
+	case TC_NOECHO:
+		typtr->tyiecho = FALSE;
+		return (devcall)OK;
+
+	/* The counts do not fit in a devcall, so they are stored	*/
+	/*   through arg1; the handler updates them with interrupts	*/
+	/*   disabled, and so is the pair read and clear here		*/
+
+	case TC_IOVERRUN:
+		if (arg1 == 0) {
+			return (devcall)SYSERR;
+		}
+		mask = disable();
+		*(uint16 *)arg1 = typtr->tyiovr;
+		if (arg2 != 0) {
+			typtr->tyiovr = 0;
+		}
+		restore(mask);
+		return (devcall)OK;
+
+	case TC_HWOVERRUN:
+		if (arg1 == 0) {
+			return (devcall)SYSERR;
+		}
+		mask = disable();
+		*(uint16 *)arg1 = typtr->tyihwovr;
+		if (arg2 != 0) {
+			typtr->tyihwovr = 0;
+		}
+		restore(mask);
+		return (devcall)OK;
+
+	/* A speed does not fit in a devcall either: the caller reads	*/
+	/*   the current one with kserial_getbaud()			*/
+
+	case TC_SPEED:
+		if (arg1 <= 0) {
+			return (devcall)SYSERR;
+		}
+
+		/* Let the queue, and the two characters that may still	*/
+		/*   be in the UART, go out at the old speed (10 bits	*/
+		/*   each, plus a tick)					*/
+
+		while (typtr->tyohead != typtr->tyotail) {
+			sleepms(1);
+		}
+		sleepms(20000 / kserial_getbaud() + 2);
+		if (kserial_setbaud((uint32)arg1) == SYSERR) {
+			return (devcall)SYSERR;
+		}
+		return (devcall)OK;
+
+	default:			/* TC_MODEC: no cooked mode	*/
+		return (devcall)SYSERR;
+	}
+}
@@ -0,0 +1,94 @@
+/* ttyhandler.c - ttyhandle_in, ttyhandle_out, USART interrupts */
+
+#include <xinu.h>
+
+/* avr specific */
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#if Ntty > 0
+
+/*------------------------------------------------------------------------
+ *  ttyhandle_in  -  Queue an arriving character for ttygetc, echoing it
+ *		     if the output queue has room
+ *------------------------------------------------------------------------
+ */
+local	void	ttyhandle_in(		/* Assumes interrupts disabled	*/
+	  struct ttycblk *typtr		/* Pointer to ttytab entry	*/
+	)
+{
+	byte	status;			/* UCSR0A before reading UDR0	*/
+	char	ch;			/* Character received		*/
+
+	status = UCSR0A;
+	ch = UDR0;
+	if (status & (1 << DOR0)) {
+		typtr->tyihwovr++;	/* Chars came in while the one	*/
+	}				/*   before was still unread	*/
+
+	if (ch == TY_RETURN && typtr->tyicrlf) {
+		ch = TY_NEWLINE;
+	}
+
+	/* If the input buffer is full, drop the character */
+
+	if ((byte)(typtr->tyitail - typtr->tyihead) >= TY_IBUFLEN) {
+		typtr->tyiovr++;
+		return;
+	}
+	typtr->tyibuff[typtr->tyitail++ & (TY_IBUFLEN - 1)] = ch;
+	signal_isr(typtr->tyisem);
+
+	/* Echo without waiting: drop the echo if the output is full */
+
+	if (typtr->tyiecho) {
+		if (ch == TY_NEWLINE && typtr->tyocrlf) {
+			if (semtry(typtr->tyosem) != OK) {
+				return;
+			}
+			typtr->tyobuff[typtr->tyotail++ & (TY_OBUFLEN - 1)]
+				= TY_RETURN;
+		}
+		if (semtry(typtr->tyosem) == OK) {
+			typtr->tyobuff[typtr->tyotail++ & (TY_OBUFLEN - 1)]
+				= ch;
+		}
+		ttykickout();
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  ttyhandle_out  -  Send the next queued character, or stop the
+ *		      transmit interrupt when the queue is empty
+ *------------------------------------------------------------------------
+ */
+local	void	ttyhandle_out(		/* Assumes interrupts disabled	*/
+	  struct ttycblk *typtr		/* Pointer to ttytab entry	*/
+	)
+{
+	if (typtr->tyohead == typtr->tyotail) {
+		UCSR0B &= ~(1 << UDRIE0);
+		return;
+	}
+	UDR0 = typtr->tyobuff[typtr->tyohead++ & (TY_OBUFLEN - 1)];
+	signal_isr(typtr->tyosem);	/* One more free slot		*/
+}
+
+/*------------------------------------------------------------------------
+ *  USART interrupts: the ATmega328P has a single UART, which is tty
+ *  minor 0.  A writer or reader released here runs at isr_exit()
+ *------------------------------------------------------------------------
+ */
+ISR(USART_RX_vect)
+{
+	ttyhandle_in(&ttytab[0]);
+	isr_exit();
+}
+
+ISR(USART_UDRE_vect)
+{
+	ttyhandle_out(&ttytab[0]);
+	isr_exit();
+}
+
+#endif
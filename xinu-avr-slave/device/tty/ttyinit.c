@@ -0,0 +1,52 @@
+/* ttyinit.c - ttyinit */
+
+#include <xinu.h>
+
+/* avr specific */
+#include <avr/io.h>
+
+#if (TY_IBUFLEN & (TY_IBUFLEN - 1)) != 0 || TY_IBUFLEN > 128	\
+ || (TY_OBUFLEN & (TY_OBUFLEN - 1)) != 0 || TY_OBUFLEN > 128
+#error "TY_IBUFLEN and TY_OBUFLEN must be powers of 2 no larger than 128"
+#endif
+
+struct	ttycblk	ttytab[Ntty];
+
+/*------------------------------------------------------------------------
+ *  ttyinit  -  Initialize buffers and modes for a tty line
+ *------------------------------------------------------------------------
+ */
+devcall	ttyinit(
+	  const __flash struct dentry *devptr	/* Entry in device switch table	*/
+	)
+{
+	struct	ttycblk	*typtr;		/* Pointer to ttytab entry	*/
+
+	typtr = &ttytab[devptr->dvminor];
+
+	/* Initialize values in the tty control block */
+
+	typtr->tyihead = typtr->tyitail = 0;
+	typtr->tyisem = semcreate(0);		/* No chars yet		*/
+	typtr->tyohead = typtr->tyotail = 0;
+	typtr->tyosem = semcreate(TY_OBUFLEN);	/* All slots are free	*/
+	if (typtr->tyisem == SYSERR || typtr->tyosem == SYSERR) {
+		return SYSERR;
+	}
+
+	/* Raw mode: the boards exchange single command characters */
+
+	typtr->tyimode = TY_IMRAW;
+	typtr->tyiecho = FALSE;
+	typtr->tyicrlf = FALSE;
+	typtr->tyocrlf = FALSE;
+	typtr->tyiovr = 0;
+	typtr->tyihwovr = 0;
+
+	/* The UART itself was set up by kserial_init (platinit).  Only	*/
+	/*   the receive interrupt is enabled here; the transmit one is	*/
+	/*   enabled by ttykickout while there is output queued		*/
+
+	UCSR0B |= (1 << RXCIE0);
+	return OK;
+}
@@ -0,0 +1,16 @@
+/* ttykickout.c - ttykickout */
+
+#include <xinu.h>
+
+/* avr specific */
+#include <avr/io.h>
+
+/*------------------------------------------------------------------------
+ *  ttykickout  -  "Kick" the UART by enabling the data register empty
+ *		     interrupt, which sends the output queue
+ *------------------------------------------------------------------------
+ */
+void	ttykickout(void)		/* Assumes interrupts disabled	*/
+{
+	UCSR0B |= (1 << UDRIE0);
+}
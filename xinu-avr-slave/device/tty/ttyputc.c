@@ -0,0 +1,32 @@
+/* ttyputc.c - ttyputc */
+
+#include <xinu.h>
+
+/*------------------------------------------------------------------------
+ *  ttyputc  -  Queue a character for the UART, blocking while the
+ *		  output buffer is full
+ *------------------------------------------------------------------------
+ */
+devcall	ttyputc(
+	  const __flash struct dentry *devptr,	/* Entry in device switch table	*/
+	  char	ch			/* Character to write		*/
+	)
+{
+	struct	ttycblk	*typtr;		/* Pointer to tty control block	*/
+
+	typtr = &ttytab[devptr->dvminor];
+
+	/* Handle output CRLF by sending CR first */
+
+	if ( ch==TY_NEWLINE && typtr->tyocrlf ) {
+		ttyputc(devptr, TY_RETURN);
+	}
+
+	wait(typtr->tyosem);		/* Wait for space in queue */
+	typtr->tyobuff[typtr->tyotail++ & (TY_OBUFLEN - 1)] = ch;
+
+	/* Start output in case device is idle */
+
+	ttykickout();
+	return OK;
+}
@@ -2,14 +2,22 @@
 
 /* avr specific values. Original saved under orig/ folder */
 
-/* General type declarations used throughout the kernel */
+/* General type declarations used throughout the kernel.  int16 and	*/
+/*   uint16 are short and int32 and uint32 are 32 bits, as on the AVR,	*/
+/*   also in the host build (see host/), where long has 64 bits, so	*/
+/*   that wraparound behaves the same there				*/
 
 typedef	unsigned char	byte;
 typedef	unsigned char	uint8;
+#if __SIZEOF_LONG__ > 4
+typedef	int		int32;
+typedef	unsigned int	uint32;
+#else
 typedef	long		int32;
-typedef	int		int16;
 typedef	unsigned long	uint32;
-typedef	unsigned int	uint16;
+#endif
+typedef	short		int16;
+typedef	unsigned short	uint16;
 typedef	unsigned long long uint64;
 
 /* Xinu-specific types */
@@ -22,6 +30,7 @@ typedef	byte	bool8;		/* Boolean type				*/
 /* Xinu-specific types */
 
 typedef int   sid32;          /* semaphore ID                         */
+typedef int16   mid16;          /* mutex ID                             */
 typedef int16   qid16;          /* queue ID                             */
 typedef int32   pid32;          /* process ID                           */
 typedef int32   did32;          /* device ID                            */
@@ -0,0 +1,54 @@
+/* klog.h - klog */
+
+/* Binary deferred logging.  klog() works like kprintf() but formats	*/
+/*   nothing on the AVR: the format string stays in flash and only its	*/
+/*   address goes into a RAM ring, followed by the arguments in binary.	*/
+/*   The log daemon sends the ring out through CONSOLE, blocking while	*/
+/*   the tty output queue is full, and tools/klogdec rebuilds the text	*/
+/*   on the host from the ELF file.  CONSOLE must keep raw output (the	*/
+/*   default; TC_MODEK would add a CR before each 0x0a byte).  Each	*/
+/*   record is								*/
+/*									*/
+/*	KLSYNC  fmt[2]  tick[2]  len  args[len]				*/
+/*									*/
+/*   (little-endian; tick is the low half of clkticks).  %d %u %x %c	*/
+/*   take two bytes, %ld %lu %lx four; %s is not supported.  klog()	*/
+/*   may be called from interrupt handlers; records that do not fit	*/
+/*   are counted and reported as lost with fmt 0.			*/
+/*									*/
+/*	klog("speed %d lap %lu\n", speed, laptime);			*/
+
+#ifndef	KLOG
+#define	KLOG		0	/* 1 = binary deferred logging (klog)	*/
+#endif
+
+#ifndef	KLOGLEN
+#define	KLOGLEN		64	/* Ring size in bytes (power of 2)	*/
+#endif
+
+#ifndef	KLOGSTACK
+#define	KLOGSTACK	96	/* Log daemon stack (bytes)		*/
+#endif
+
+#ifndef	KLOGPRIO
+#define	KLOGPRIO	10	/* Log daemon priority: that of the null*/
+				/*   process and the application tasks	*/
+#endif
+
+#define	KLSYNC		0xa5	/* First byte of every record		*/
+#define	KLHDR		6	/* Bytes before the arguments		*/
+#define	KLNOTE		0x01	/* Notification bit for the daemon	*/
+
+#if KLOG
+
+#define	klog(fmt, ...)							\
+	klogf(({ static const __flash char klfmt[] = fmt; klfmt; }),	\
+	      ##__VA_ARGS__)
+
+extern	struct	xtask	klogd_xtask;	/* Log daemon (XINU_TASK)	*/
+
+#else
+
+#define	klog(fmt, ...)
+
+#endif
@@ -8,8 +8,12 @@
  * roundmb, truncmb - Round or truncate address to memory block size
  *----------------------------------------------------------------------
  */
-#define	roundmb(x)	(char *)( (7 + (uint32)(x)) & (~7) )
-#define	truncmb(x)	(char *)( ((uint32)(x)) & (~7) )
+#ifndef	MBROUND
+#define	MBROUND		8	/* Block size, >= sizeof(struct memblk)	*/
+#endif
+
+#define	roundmb(x)	(char *)( (MBROUND-1 + (uint32)(x)) & (~(MBROUND-1)) )
+#define	truncmb(x)	(char *)( ((uint32)(x)) & (~(MBROUND-1)) )
 
 /*----------------------------------------------------------------------
  *  freestk  --  Free stack memory allocated by getstk
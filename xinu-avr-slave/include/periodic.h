@@ -0,0 +1,10 @@
+/* periodic.h - periodic release handles */
+
+/* A task that must run every pperiod ms keeps one of these and calls	*/
+/*   periodic_wait() at the end of each job.  Release times advance by	*/
+/*   exactly pperiod, so the time spent in the body does not add drift.	*/
+
+struct	periodic {
+	uint32	pnext;		/* Next release time (ms since boot)	*/
+	uint16	pperiod;	/* Period between releases in ms	*/
+};
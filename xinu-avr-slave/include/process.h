@@ -16,20 +16,17 @@
 #define	PR_SUSP		5	/* Process is suspended			*/
 #define	PR_WAIT		6	/* Process is on semaphore queue	*/
 #define	PR_RECTIM	7	/* Process is receiving with timeout	*/
+#define	PR_NOTIFY	8	/* Process waiting for a notification	*/
+#define	PR_NOTIM	9	/* Process notify-waiting with timeout	*/
+#define	PR_WAITIM	10	/* Process on semaphore with timeout	*/
+#define	PR_MUTEX	11	/* Process waiting for a mutex		*/
 
 /* Miscellaneous process definitions */
 
 #define	PNMLEN		8	/* Length of process "name"		*/
 #define	NULLPROC	0	/* ID of the null process		*/
 
-/* avr specific */
-
-#define PNREGS          38              /* size of saved register area  */
-#define SSP_L           32              /* saved SP (low)               */
-#define SSP_H           33              /* saved SP (high)                              */
-#define SPC_L           34              /* saved PC (low)               */
-#define SPC_H           35              /* saved PC (high)              */
-#define SSREG           36              /* saved Status Register        */
+/* avr specific: pregs layout (PNREGS, SSP_L, ...) is in pregs.h */
 
 #define	INITPS		0x80	/* initial process SREG (interrupts enabled)	*/
 #define MAXARG		4
@@ -48,19 +45,54 @@
 			  ((pid32)(x) >= NPROC) || \
 			  (proctab[(x)].prstate == PR_FREE))
 
+/* RAM-compact kernel tables.  With KCOMPACT set, every table field is	*/
+/*   sized for the AVR: the process state is a byte, the stack length	*/
+/*   16 bits, the name is a pointer to the caller's string instead of a	*/
+/*   copy, and the fields nothing reads (pargs, paddr, prstkptr and the	*/
+/*   device descriptors) are dropped; semaphore counts and queue links	*/
+/*   shrink as well (see semaphore.h and queue.h).			*/
+
+#ifndef	KCOMPACT
+#define	KCOMPACT	0
+#endif
+
+/* Number of priority-inheritance mutexes (see mutex.h) */
+
+#ifndef	NMUTEX
+#define	NMUTEX		0
+#endif
+
 /* Number of device descriptors a process can have open */
 
+#if KCOMPACT
+#define NDESC		0	/* stdin, stdout and stderr are CONSOLE	*/
+#else
 #define NDESC		5	/* must be odd to make procent 4N bytes	*/
+#endif
 
 /* Definition of the process table (multiple of 32 bits) */
 
 struct procent {		/* Entry in the process table		*/
+#if KCOMPACT
+	byte	prstate;	/* Process state: PR_CURR, etc.		*/
+#else
 	uint16	prstate;	/* Process state: PR_CURR, etc.		*/
+#endif
 	pri16	prprio;		/* Process priority			*/
 	unsigned char pregs[PNREGS];/* saved context (see ctxsw)	*/
 
+#if !KCOMPACT
 	int pargs;				/* initial number of arguments	*/
+#endif
 	void * parg[MAXARG];	/* arguments					*/
+#if KCOMPACT
+	unsigned char	*prstkbase;	/* Base of run time stack		*/
+	uint16	prstklen;	/* Stack length in bytes		*/
+	char	*prname;	/* Process name (not copied)		*/
+	sid32	prsem;		/* Semaphore on which process waits	*/
+	uint16	prwseq;		/* Ticket taken when it began to wait	*/
+	int16	prparent;	/* ID of the creating process		*/
+#else
 	int *paddr;			/* initial code address			*/
 
 	char	*prstkptr;	/* Saved stack pointer			*/
@@ -68,15 +100,65 @@ struct procent {		/* Entry in the process table		*/
 	uint32	prstklen;	/* Stack length in bytes		*/
 	char	prname[PNMLEN];	/* Process name				*/
 	sid32	prsem;		/* Semaphore on which process waits	*/
+	uint16	prwseq;		/* Ticket taken when it began to wait	*/
 	pid32	prparent;	/* ID of the creating process		*/
+#endif
 	umsg32	prmsg;		/* Message sent to this process		*/
 	bool8	prhasmsg;	/* Nonzero iff msg is valid		*/
+	uint16	prnotify;	/* Notification bits pending		*/
+	uint16	prnmask;	/* Bits awaited in notifywait		*/
+#if NMUTEX > 0
+	pri16	prbprio;	/* Priority before mutex inheritance	*/
+	mid16	prmutex;	/* Mutex on which process waits		*/
+#endif
+#if NDESC > 0
 	int16	prdesc[NDESC];	/* Device descriptors for process	*/
+#endif
+	uint16	proverrun;	/* Missed periodic deadlines		*/
+	uint16	prslhi;		/* SLCHUNK ms periods left to sleep	*/
+#if CPUACCT
+	uint32	prcpu;		/* CPU time used in us (wraps)		*/
+	uint16	prnswitch;	/* Times the process was switched in	*/
+#endif
 };
 
+/* notifywait() timeout meaning no time limit */
+
+#define	NOTIFYFOREVER	(-1)
+
 /* Marker for the top of a process stack (used to help detect overflow)	*/
 #define	STACKMAGIC	0x0A0AAAA9
 
+/* Stack painting: create() fills each stack with STKPAINT so that	*/
+/*   stkusage() can find the high-water mark, and with STKCHECK set	*/
+/*   resched() verifies the lowest STKGUARD bytes on every switch	*/
+
+#ifndef	STKCHECK
+#define	STKCHECK	0
+#endif
+
+#define	STKPAINT	0xa5	/* Fill byte for unused stack		*/
+#define	STKGUARD	2	/* Bytes at the stack limit to check	*/
+
+/* CPU accounting: with CPUACCT set, resched() charges the time since	*/
+/*   the previous switch to the outgoing process (8 us resolution) and	*/
+/*   counts how often each process is switched in; the null process's	*/
+/*   total is the idle time						*/
+
+#ifndef	CPUACCT
+#define	CPUACCT		0
+#endif
+
+/* Lowest usable address of a process stack (see getstk and freestk)	*/
+
+#define	stkbottom(p)	((byte *)((uint32)(p)->prstkbase		\
+				- (uint32)roundmb((p)->prstklen)	\
+				+ (uint32)sizeof(uint32)))
+
 extern	struct	procent proctab[];
 extern	int32	prcount;	/* Currently active processes		*/
 extern	pid32	currpid;	/* Currently executing process		*/
+extern	void	(*stkhook)(pid32); /* Overflow handler (NULL = panic)	*/
+#if CPUACCT
+extern	uint32	cpustamp;	/* getmicros() at the last switch	*/
+#endif
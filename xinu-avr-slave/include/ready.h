@@ -0,0 +1,41 @@
+/* ready.h - rdyinsert, rdyremove, rdydequeue, rdyfirstkey, rdyempty,	*/
+/*		isbadprio						*/
+
+/* Ready list selection.  With RDYBITMAP set to 0 the ready list is the	*/
+/*   classic Xinu key-ordered queue in queuetab.  With RDYBITMAP set to	*/
+/*   1 it is a priority bitmap plus one FIFO per priority level, so	*/
+/*   insertion, removal and selection take constant time.		*/
+
+#ifndef	RDYBITMAP
+#define	RDYBITMAP	0
+#endif
+
+#if RDYBITMAP
+
+#ifndef	NRDYPRIO
+#define	NRDYPRIO	32	/* Priority levels (multiple of 8, <= 64)*/
+#endif
+
+#define	RDYNONE		0xff	/* Empty FIFO marker in rdyhead		*/
+
+extern	byte	rdygrp;		/* Bit g set iff rdytbl[g] is nonzero	*/
+extern	byte	rdytbl[];	/* One bit per nonempty priority level	*/
+extern	byte	rdyhead[];	/* First process of each level's FIFO	*/
+
+/* Inline to check a priority can be represented in the bitmap */
+
+#define	isbadprio(p)	((int32)(p) < 0 || (int32)(p) >= NRDYPRIO)
+
+#define	rdyempty()	(rdygrp == 0)
+
+#else
+
+#define	rdyinsert(pid, prio)	insert((pid), readylist, (prio))
+#define	rdyremove(pid)		getitem(pid)
+#define	rdydequeue()		dequeue(readylist)
+#define	rdyfirstkey()		((int16)firstkey(readylist))
+#define	rdyempty()		isempty(readylist)
+
+#define	isbadprio(p)	(FALSE)		/* Keys are not range limited	*/
+
+#endif
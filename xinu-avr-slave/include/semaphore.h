@@ -12,9 +12,15 @@
 /* Semaphore table entry */
 struct	sentry	{
 	byte	sstate;		/* Whether entry is S_FREE or S_USED	*/
+#if KCOMPACT
+	int16	scount;		/* Count for the semaphore		*/
+#else
 	int32	scount;		/* Count for the semaphore		*/
+#endif
 	qid16	squeue;		/* Queue of processes that are waiting	*/
 				/*     on the semaphore			*/
+	uint16	sseq;		/* Ticket for the next waiter		*/
+	byte	stimed;		/* Timed waiters, kept on sleepq	*/
 };
 
 extern	struct	sentry semtab[];
@@ -0,0 +1,42 @@
+/* swtimer.h - software timers */
+
+/* Software timers run a callback once or periodically without a	*/
+/*   process of their own: the clock handler wakes the timer daemon,	*/
+/*   which runs every expired callback with interrupts enabled.  The	*/
+/*   daemon is a static task (TMDSTACK bytes of stack, priority		*/
+/*   TMDPRIO) whose process table slot conf.h adds to NPROC.  Callbacks	*/
+/*   must not block; they may signal, notify, send or restart timers.	*/
+/*									*/
+/*	struct swtimer blink;						*/
+/*	tmstart(&blink, 500, 500, toggle, NULL);	every 500 ms	*/
+/*	tmstart(&gate, 3000, 0, close_gate, &g);	once, in 3 s	*/
+
+#ifndef	SWTIMER
+#define	SWTIMER		0	/* 1 = software timer service		*/
+#endif
+
+#ifndef	TMDSTACK
+#define	TMDSTACK	96	/* Timer daemon stack (bytes)		*/
+#endif
+
+#ifndef	TMDPRIO
+#define	TMDPRIO		30	/* Timer daemon priority		*/
+#endif
+
+#define	TMNOTE		0x01	/* Notification bit for the daemon	*/
+
+struct	swtimer	{
+	struct	swtimer	*tmnext;	/* Next timer to expire		*/
+	uint32	tmexpiry;		/* clkticks when it expires	*/
+	uint16	tmperiod;		/* Reload in ms, 0 for one-shot	*/
+	void	(*tmfunc)(void *);	/* Callback			*/
+	void	*tmarg;			/* Argument for the callback	*/
+	bool8	tmactive;		/* On the active list		*/
+};
+
+extern	struct	swtimer	*tmlist;	/* Active timers, soonest first	*/
+extern	struct	xtask	tmd_xtask;	/* Timer daemon (XINU_TASK)	*/
+
+/* Inline to test from the clock handler whether a timer is due */
+
+#define	tmdue()	(tmlist != NULL && (int32)(clkticks - tmlist->tmexpiry) >= 0)
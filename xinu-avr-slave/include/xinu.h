@@ -8,15 +8,28 @@
 
 #include <kernel.h>
 #include <conf.h>
+#include <pregs.h>
 #include <process.h>
 #include <queue.h>
+#include <ready.h>
 #include <resched.h>
 #include <semaphore.h>
+#include <mutex.h>
+#include <ring.h>
+#include <mqueue.h>
 #include <memory.h>
+#include <mpool.h>
 #include <bufpool.h>
 #include <mark.h>
 #include <ports.h>
 #include <timer.h>
+#include <periodic.h>
+#include <trace.h>
+#include <xtask.h>
+#include <swtimer.h>
+#include <dwork.h>
+#include <klog.h>
+#include <coro.h>
 #include <uart.h>	/* avr UART peripheral */
 #include <tty.h>
 #include <device.h>
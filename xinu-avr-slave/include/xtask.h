@@ -0,0 +1,42 @@
+/* xtask.h - XINU_TASK, XINU_TASKPID */
+
+/* Static processes.  XINU_TASK reserves the stack in .bss and adds the	*/
+/*   task to a table built before nulluser runs (each declaration puts	*/
+/*   a small fragment in the .init7 startup section, which the avr-libc	*/
+/*   linker script always keeps).  The kernel creates every task,	*/
+/*   suspended, before main starts, so the linker accounts for their	*/
+/*   RAM and creation cannot fail at run time; main resumes them:	*/
+/*									*/
+/*	XINU_TASK(sd, task_sd_loader, 180, 20);				*/
+/*	...								*/
+/*	resume(XINU_TASKPID(sd));					*/
+
+struct	xtask	{			/* Entry in the static task table*/
+	struct	xtask	*xnext;		/* Next task, in declaration order*/
+	int	(*xfunc)();		/* Procedure to run		*/
+	byte	*xstk;			/* Lowest address of the stack	*/
+	uint16	xssize;			/* Stack size (multiple of 8)	*/
+	pri16	xprio;			/* Initial priority		*/
+	char	*xname;			/* Process name			*/
+	pid32	xpid;			/* Process ID once created	*/
+};
+
+extern	struct	xtask	*xtasklist;	/* First static task		*/
+extern	struct	xtask	**xtasktail;	/* Where to link the next one	*/
+
+#define	XINU_TASK(name, fn, stack, prio)				\
+	static	byte	name##_xstk[((stack) + 7) & ~7];		\
+	struct	xtask	name##_xtask = {				\
+		NULL, (int (*)())(fn), name##_xstk,			\
+		sizeof(name##_xstk), (prio), #name, SYSERR		\
+	};								\
+	static	void	name##_xlink(void)				\
+		__attribute__((naked, used, section(".init7")));	\
+	static	void	name##_xlink(void)				\
+	{								\
+		*xtasktail = &name##_xtask;				\
+		xtasktail = &name##_xtask.xnext;			\
+	}								\
+	extern	struct	xtask	name##_xtask
+
+#define	XINU_TASKPID(name)	(name##_xtask.xpid)
@@ -4,13 +4,19 @@
 void change_proc_name( char *name)
 {
 	struct	procent	*prptr;		/* pointer to proc. table entry */
+#if !KCOMPACT
 	int i;
+#endif
 
 
 	prptr = &proctab[currpid];
 
+#if KCOMPACT
+	prptr->prname = name;		/* Caller's string is kept	*/
+#else
 	prptr->prname[PNMLEN-1] = NULLCH;
 	for (i=0 ; i<PNMLEN-1 && (prptr->prname[i]=name[i])!=NULLCH; i++)
 		;
+#endif
 }
 
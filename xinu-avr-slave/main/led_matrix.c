@@ -2,6 +2,7 @@
  * led_matrix.c
  */
 
+#include <xinu.h>
 #include "led_matrix.h"
 #include "gpio.h"
 #ifndef _SIZE_T_DEFINED
@@ -33,7 +34,7 @@ void matrix_clear(void) {
     }
 }
 
-void matrix_render_frame(uint16_t state) {
+void matrix_render_frame(uint16_t state, struct periodic *row_period) {
 	uint8_t r, c;
     // Itero sobre las 4 filas
     for (r = 0; r < 4; r++) {
@@ -55,7 +56,7 @@ void matrix_render_frame(uint16_t state) {
         // Encender fila
         gpio_pin(get_row_pin(r), 1);
 		
-        sleepms(3);
+        periodic_wait(row_period); // Tiempo de fila fijo aunque el render demore
         
         // Apagar fila
         gpio_pin(get_row_pin(r), 0);
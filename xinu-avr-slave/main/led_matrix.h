@@ -22,7 +22,10 @@
 
 void matrix_init(void);
 
-void matrix_render_frame(uint16_t state);
+struct periodic;
+
+// Dibuja un frame fila por fila; cada fila espera su liberacion periodica
+void matrix_render_frame(uint16_t state, struct periodic *row_period);
 
 void matrix_clear(void);
 
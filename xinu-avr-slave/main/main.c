@@ -43,12 +43,13 @@ const uint16_t SEQ_Z[] PROGMEM = { 0x0660, 0x0FF0, 0xFFFF, 0x0FF0 }; // Expansio
 /* --- GLOBALES COMPARTIDAS --- */
 unsigned char audio_buffer[BUFFER_SIZE]; // hasta 512 bytes de RAM (dependiendo del valor configurado en "BUFFER_SIZE")
 
-// Semforo
-sid32 sem_sd_request;
+// Notificaciones a la tarea de la SD (mitad del buffer a recargar)
+#define NOTE_FILL_LO 0x01
+#define NOTE_FILL_HI 0x02
+extern struct xtask sd_xtask; // Definida mas abajo por XINU_TASK(sd, ...)
 
 // Estado Audio
 volatile unsigned int play_index = 0;
-volatile uint8_t fill_request_part = 0;
 volatile uint8_t is_playing = 0;
 
 // Estado Matriz LED (Volatile para acceso concurrente)
@@ -63,24 +64,24 @@ void audio_isr_logic(void) {
 	play_index++;
 
 	if (play_index == HALF_BUFFER) {
-		fill_request_part = 0;
-		signal(sem_sd_request);
+		notify_isr(XINU_TASKPID(sd), NOTE_FILL_LO); // Sin resched dentro de la ISR
 	}
 	else if (play_index == BUFFER_SIZE) {
 		play_index = 0;
-		fill_request_part = 1;
-		signal(sem_sd_request);
+		notify_isr(XINU_TASKPID(sd), NOTE_FILL_HI);
 	}
 }
 
 /* --- TAREA 1: CARGADOR SD (Prioridad 20) --- */
 void task_sd_loader(void) {
     uint16_t current_block = 0;
+    int32 note;
     while(1) {
-        wait(sem_sd_request);
-        if (fill_request_part == 0) {
+        note = notifywait(NOTE_FILL_LO | NOTE_FILL_HI, NOTIFYFOREVER);
+        if (note & NOTE_FILL_LO) {
             sd_read_partial(MUSIC_START_BLOCK + current_block, audio_buffer, 0, HALF_BUFFER);
-        } else {
+        }
+        if (note & NOTE_FILL_HI) {
             sd_read_partial(MUSIC_START_BLOCK + current_block, audio_buffer, HALF_BUFFER, HALF_BUFFER);
             current_block++;
             if (current_block >= (uint16_t)TOTAL_MUSIC_BLOCKS) current_block = 0;
@@ -93,10 +94,13 @@ void task_led_matrix(void) {
     uint8_t frame_idx = 0;
     uint8_t refresh_counter = 0;
     uint16_t frame_data;
+    struct periodic row_period;
+
+    periodic_init(&row_period, 3); // Una fila cada 3 ms, sin deriva
 
     while(1) {
         frame_data = pgm_read_word(&current_seq_ptr[frame_idx]);
-        matrix_render_frame(frame_data);
+        matrix_render_frame(frame_data, &row_period);
         refresh_counter++;
         if (refresh_counter >= led_speed_cycles) {
             refresh_counter = 0;
@@ -132,6 +136,11 @@ void task_serial(void) {
                 }
                 break;
 
+            // --- VELOCIDAD DEL ENLACE ---
+            case SERIAL_SPEED: // 'S' + codigo (ver serial.c)
+                serial_speed_request();
+                break;
+
             // --- PATRONES LED ---
             case 'U': 
 				current_seq_ptr = SEQ_U; 
@@ -184,41 +193,24 @@ void hardware_init(void) {
 	timer1_init(audio_isr_logic);
 }
 
+/* --- TAREAS ESTATICAS --- */
+// Pila reservada en .bss; el kernel las crea (suspendidas) antes de main
+XINU_TASK(sd,  task_sd_loader,  180, 20);
+XINU_TASK(led, task_led_matrix, 120, 15);
+XINU_TASK(ser, task_serial,     100, 10);
+
 /* --- MAIN --- */
 void main(void) {
     hardware_init();
     sleepms(5000);  // Espera relativamente grande para que se aprecie el mensaje "Cargando..." en la LCD
 
-    sem_sd_request = semcreate(0);
-
     // Precarga Audio
     sd_read_partial(MUSIC_START_BLOCK, audio_buffer, 0, HALF_BUFFER);
     sd_read_partial(MUSIC_START_BLOCK, audio_buffer, HALF_BUFFER, HALF_BUFFER);
     
-    pid32 pid_audio  = create(task_sd_loader,  180, 20, "sd", 0);
-    pid32 pid_matrix = create(task_led_matrix, 120, 15, "led", 0);
-    pid32 pid_serial = create(task_serial,     100, 10, "ser", 0);
-
-	if (pid_audio == SYSERR) {
-		//serial_put_str_flash(PSTR("Err:RAM Audio\r\n"));
-		} else {
-		resume(pid_audio);
-		//serial_put_str_flash(PSTR("Audio OK\r\n"));
-}
-
-	if (pid_matrix == SYSERR) {
-		//serial_put_str_flash(PSTR("Err:RAM Matrix\r\n"));
-		} else {
-		resume(pid_matrix);
-		//serial_put_str_flash(PSTR("Matrix OK\r\n"));
-	}
-
-	if (pid_serial == SYSERR) {
-		//serial_put_str_flash(PSTR("Err:RAM Serial\r\n"));
-		} else {
-		resume(pid_serial);
-		//serial_put_str_flash(PSTR("Serial OK\r\n"));
-	}
+    resume(XINU_TASKPID(sd));
+    resume(XINU_TASKPID(led));
+    resume(XINU_TASKPID(ser));
 
     return;
 }
\ No newline at end of file
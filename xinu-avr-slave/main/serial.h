@@ -7,8 +7,19 @@
 #ifndef _SERIAL_H
 #define _SERIAL_H
 
+/* Negociacion de velocidad del enlace maestro-esclavo (ver serial.c) */
+#define SERIAL_READY	'A'	/* Esclavo listo / confirmacion de velocidad */
+#define SERIAL_SPEED	'S'	/* Pedido de velocidad, seguido del codigo */
+#define SERIAL_ACK	'K'	/* El esclavo acepta la velocidad */
+#define SERIAL_NAK	'N'	/* El esclavo no la soporta */
+#define SERIAL_CODE0	'a'	/* Codigo de serial_speeds[0] (ver serial.c) */
+#define SERIAL_WAITMS	100	/* Espera maxima de cada respuesta (ms) */
+#define SERIAL_NOCHAR	(-1)	/* serial_get_char_timeout: no llego nada */
+
 void serial_init(void);
 char serial_get_char(void);
+int serial_get_char_timeout(unsigned int ms);
 void serial_put_str_flash(const char *str); // Prototipo para strings en Flash
+void serial_speed_request(void);
 
-#endif /* _SERIAL_H */
\ No newline at end of file
+#endif /* _SERIAL_H */
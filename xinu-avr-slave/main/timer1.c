@@ -2,6 +2,7 @@
  * timer1.c - Driver del TIMER1
  */
 
+#include <xinu.h>
 #include "timer1.h"
 #include <stdint.h> 
 //#include <stddef.h> // Para NULL
@@ -80,4 +81,5 @@ ISR(TIMER1_COMPA_vect)
     if (timer1_callback_ptr != NULL) {
         timer1_callback_ptr(); // Ejecutar lgica de audio
     }
+    isr_exit(); // Un solo resched al salir si signal_isr() lo pidio
 }
\ No newline at end of file
@@ -21,9 +21,10 @@ volatile unsigned char *timer2_timsk2 = (unsigned char *)(0x70);
 
 
 uint32	clktime;		/* Seconds since boot			*/
-unsigned long  count1000;	/* ms since last clock tick             */
+uint32	clkticks;		/* Milliseconds since boot		*/
+uint32	count1000;	/* ms since last clock tick             */
 qid16	sleepq;			/* Queue of sleeping processes		*/
-unsigned long preempt;		/* Preemption counter			*/
+uint32	preempt;		/* Preemption counter			*/
 
 /*------------------------------------------------------------------------
  * clkinit  -  Initialize the clock and sleep queue at startup
@@ -38,6 +39,7 @@ void clkinit(void)
 				/*   list of sleeping processes		*/
 	preempt = QUANTUM;	/* Set the preemption time		*/
 	clktime = 0;		/* Start counting seconds		*/
+	clkticks = 0;		/* Start counting milliseconds		*/
         count1000 = 0;
 
 
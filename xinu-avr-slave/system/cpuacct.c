@@ -0,0 +1,115 @@
+/* cpuacct.c - cpureport, cpumon */
+
+#include <xinu.h>
+
+#if CPUACCT
+
+#ifndef	CONSOLE
+#error "cpureport sends its frames through the CONSOLE device"
+#endif
+
+uint32	cpustamp;			/* getmicros() at the last switch*/
+
+#define	CPUSYNC0	0xc5		/* Report frame start bytes	*/
+#define	CPUSYNC1	0x5c
+#define	CPUREPORTMS	1000		/* cpumon reporting period (ms)	*/
+#define	CPUHDR		7		/* Sync, now and n		*/
+#define	CPUREC		7		/* Bytes per process		*/
+
+/* The frame is built in a static buffer rather than on the stack of	*/
+/*   the process that sends it (7 bytes per process); cpureport() is	*/
+/*   therefore meant to be called by one process only, normally cpumon	*/
+
+local	byte	cpuframe[CPUHDR + CPUREC * NPROC + 1];
+
+/*------------------------------------------------------------------------
+ *  cpuputn  -  Store the low n bytes of a value, least significant
+ *		  first, and return where the next byte goes
+ *------------------------------------------------------------------------
+ */
+local	byte	*cpuputn(
+	  byte		*p,		/* Where to store		*/
+	  uint32	val,		/* Value to store		*/
+	  int16		n		/* Number of bytes		*/
+	)
+{
+	while (n-- > 0) {
+		*p++ = (byte)val;
+		val >>= 8;
+	}
+	return p;
+}
+
+/*------------------------------------------------------------------------
+ *  cpureport  -  Send a binary snapshot of per-process CPU usage through
+ *		    CONSOLE, which must keep raw output (the tty default):
+ *
+ *	0xc5 0x5c now[4] n[1] { pid[1] nswitch[2] cpu[4] } * n  xor[1]
+ *
+ *  now and cpu are in us and wrap; load is computed on the host from the
+ *  difference between two reports, the null process (pid 0) being idle.
+ *  xor covers every byte after the two sync bytes.
+ *------------------------------------------------------------------------
+ */
+void	cpureport(void)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	struct	procent	*prptr;		/* Ptr to process's table entry	*/
+	uint32	now;			/* Time of the snapshot (us)	*/
+	uint32	cpu;			/* CPU time of one process	*/
+	byte	*p;			/* Next byte of the frame	*/
+	byte	*q;
+	pid32	pid;
+	byte	n;
+	byte	sum;
+
+	/* Pack the snapshot with interrupts off, then write it with	*/
+	/*   them on: write() waits on the tty output queue while the	*/
+	/*   UART drains, and other processes run meanwhile		*/
+
+	mask = disable();
+	now = getmicros();
+	p = cpuframe + CPUHDR;
+	n = 0;
+	for (pid = 0; pid < NPROC; pid++) {
+		prptr = &proctab[pid];
+		if (prptr->prstate == PR_FREE) {
+			continue;
+		}
+		cpu = prptr->prcpu;
+		if (pid == currpid) {	/* Include the running slice	*/
+			cpu += now - cpustamp;
+		}
+		*p++ = pid;
+		p = cpuputn(p, prptr->prnswitch, 2);
+		p = cpuputn(p, cpu, 4);
+		n++;
+	}
+	restore(mask);
+
+	cpuframe[0] = CPUSYNC0;
+	cpuframe[1] = CPUSYNC1;
+	cpuputn(cpuframe + 2, now, 4);
+	cpuframe[6] = n;
+	sum = 0;
+	for (q = cpuframe + 2; q < p; q++) {
+		sum ^= *q;
+	}
+	*p++ = sum;
+	write(CONSOLE, (char *)cpuframe, p - cpuframe);
+}
+
+/*------------------------------------------------------------------------
+ *  cpumon  -  Process that sends the CPU report once a second
+ *------------------------------------------------------------------------
+ */
+process	cpumon(void)
+{
+	while (TRUE) {
+		sleepms(CPUREPORTMS);
+		cpureport();
+	}
+	return OK;
+}
+
+#endif
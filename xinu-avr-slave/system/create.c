@@ -1,11 +1,16 @@
-/* create.c - create, newpid */
+/* create.c - create, createat, procinit, newpid */
 
 /* avr specific */
 
 #include <stdarg.h>
 #include <xinu.h>
 
+/* avr specific */
+#include <avr/io.h>
+
 local	pid32 newpid();
+local	void procinit(pid32, int (*)(), unsigned char *, int, int, char *,
+		int, int *);
 
 #define	roundew(x)	( (x+3)& ~0x3)
 
@@ -28,8 +33,6 @@ pid32	create(
 {
 	intmask 	mask;    	/* interrupt mask		*/
 	pid32		pid;		/* stores new process id	*/
-	struct	procent	*prptr;		/* pointer to proc. table entry */
-	int i;
 	unsigned char		*saddr;		/* stack address		*/
 	va_list ap;
 
@@ -37,60 +40,140 @@ pid32	create(
 	if (ssize < MINSTK)
 		ssize = MINSTK;
 	ssize = (int) roundew(ssize);
-	if (((saddr = (unsigned char *)getstk(ssize)) ==
+	if (priority < 1 || isbadprio(priority) ||
+	    ((saddr = (unsigned char *)getstk(ssize)) ==
 	     (uint32 *)SYSERR ) ||
-	     (pid=newpid()) == SYSERR || priority < 1 ) {
+	     (pid=newpid()) == SYSERR ) {
 		avr_kprintf(m10);
 		restore(mask);
 		return SYSERR;
 	}
+	procinit(pid, procaddr, saddr, ssize, priority, name, nargs,
+		 (int *)(&nargs + 1));
 
+	restore(mask);
+	return pid;
+}
+
+/*------------------------------------------------------------------------
+ *  createat  -  create a process on a stack provided by the caller (see
+ *		   XINU_TASK); ssize must be a multiple of 8
+ *------------------------------------------------------------------------
+ */
+pid32	createat(
+	  int		(*procaddr)(),	/* procedure address		*/
+	  byte		*stk,		/* lowest address of the stack	*/
+	  int		ssize,		/* stack size in bytes		*/
+	  int		priority,	/* process priority > 0		*/
+	  char		*name		/* name (for debugging)		*/
+	)
+{
+	intmask 	mask;    	/* interrupt mask		*/
+	pid32		pid;		/* stores new process id	*/
+
+	mask = disable();
+	if (priority < 1 || isbadprio(priority) || ssize < MINSTK ||
+	    (ssize & 7) != 0 || (pid=newpid()) == SYSERR ) {
+		restore(mask);
+		return SYSERR;
+	}
+	procinit(pid, procaddr, stk + ssize - sizeof(uint32), ssize,
+		 priority, name, 0, NULL);
+
+	restore(mask);
+	return pid;
+}
+
+/*------------------------------------------------------------------------
+ *  procinit  -  initialize the table entry and stack of a new process
+ *------------------------------------------------------------------------
+ */
+local	void	procinit(
+	  pid32		pid,		/* new process id		*/
+	  int		(*procaddr)(),	/* procedure address		*/
+	  unsigned char	*saddr,		/* highest word of the stack	*/
+	  int		ssize,		/* stack size in bytes		*/
+	  int		priority,	/* process priority > 0		*/
+	  char		*name,		/* name (for debugging)		*/
+	  int		nargs,		/* number of args		*/
+	  int		*a		/* the args themselves		*/
+	)
+{
+	struct	procent	*prptr;		/* pointer to proc. table entry */
+	int i;
+	unsigned char		*paint, *ptop;	/* stack painting bounds	*/
 
-	
 	prcount++;
 	prptr = &proctab[pid];
 
 	/* initialize process table entry for new process */
 	prptr->prstate = PR_SUSP;	/* initial state is suspended	*/
 	prptr->prprio = priority;
+#if NMUTEX > 0
+	prptr->prbprio = priority;
+	prptr->prmutex = EMPTY;
+#endif
 	prptr->prstkbase = (char *)saddr;
 	prptr->prstklen = ssize;
+#if KCOMPACT
+	prptr->prname = name;		/* Caller's string is kept	*/
+#else
 	prptr->prname[PNMLEN-1] = NULLCH;
 	for (i=0 ; i<PNMLEN-1 && (prptr->prname[i]=name[i])!=NULLCH; i++)
 		;
+#endif
 	prptr->prsem = -1;
 	prptr->prparent = (pid32)getpid();
 	prptr->prhasmsg = FALSE;
-
+	prptr->prnotify = 0;
+	prptr->prnmask = 0;
+	prptr->proverrun = 0;
+#if CPUACCT
+	prptr->prcpu = 0;
+	prptr->prnswitch = 0;
+#endif
+
+#if NDESC > 0
 	/* set up initial device descriptors for the shell		*/
 	prptr->prdesc[0] = CONSOLE;	/* stdin  is CONSOLE device	*/
 	prptr->prdesc[1] = CONSOLE;	/* stdout is CONSOLE device	*/
 	prptr->prdesc[2] = CONSOLE;	/* stderr is CONSOLE device	*/
+#endif
+
 
+	/* Paint the stack for stkusage(), stopping below SP in case	*/
+	/*   the region holds the live stack (the null process keeps	*/
+	/*   running on the boot stack at the top of RAM)		*/
+	ptop = saddr;
+	if (ptop >= (unsigned char *)SP)
+		ptop = (unsigned char *)SP;
+	for (paint = stkbottom(prptr); paint < ptop; paint++)
+		*paint = STKPAINT;
 
 	/* Initialize stack as if the process was called		*/
 	*saddr-- = (char)MAGIC;		/* Bottom of stack */
+#if !KCOMPACT
 	prptr->pargs = nargs;
+#endif
 	for (i=0 ; i<PNREGS ; i++)		// VER TAMANIO PARA AVR
 		prptr->pregs[i] = INITREG;	
+#if !KCOMPACT
 	prptr->paddr = (int *)procaddr;
-	prptr->pregs[SPC_L] = lobyte((unsigned) procaddr); // GUARDAR SPC_L
-	prptr->pregs[SPC_H] = hibyte((unsigned) procaddr);
+#endif
 	prptr->pregs[SSREG] = INITPS;
 	// POR AHORA NO  (usado en kill.c en avr orig : prptr->pnxtkin = BADPID;
 	// POR AHORA NO prptr->pdevs[0] = prptr->pdevs[1] = BADDEV;
 	
-	int * a = (int *)(&nargs + 1);
 	for (i = 0; i < nargs; i++) {
 		prptr->parg[i] = (int) *a++;
 	}
 	prptr->parg[nargs] = 0;
 	
 	/* machine/compiler dependent pass arguments to created process */
-	prptr->pregs[24] = lobyte((unsigned)prptr->pargs);	/*r24*/
-	prptr->pregs[25] = hibyte((unsigned)prptr->pargs);
-	prptr->pregs[22] = lobyte((unsigned)&prptr->parg[0]);	/*r22*/
-	prptr->pregs[23] = hibyte((unsigned)&prptr->parg[0]);
+	prptr->pregs[SR24] = lobyte((unsigned)nargs);	/*r24*/
+	prptr->pregs[SR24+1] = hibyte((unsigned)nargs);
+	prptr->pregs[SR22] = lobyte((unsigned)&prptr->parg[0]);	/*r22*/
+	prptr->pregs[SR22+1] = hibyte((unsigned)&prptr->parg[0]);
 
 	*saddr-- = lobyte((unsigned)INITRET);	/* push on initial return address*/
 	*saddr-- = hibyte((unsigned)INITRET);
@@ -98,9 +181,6 @@ pid32	create(
 	*saddr-- = hibyte((unsigned)procaddr);
 	prptr->pregs[SSP_L] = lobyte((unsigned) saddr);
 	prptr->pregs[SSP_H] = hibyte((unsigned) saddr);
-
-	restore(mask);
-	return pid;
 }
 
 /*------------------------------------------------------------------------
@@ -0,0 +1,110 @@
+/* dwork.c - dwpost_isr, dwpost, dwreport, dwdaemon */
+
+#include <xinu.h>
+
+#if DWORK
+
+local	struct	dwork	*dwhead;	/* Pending items, oldest first	*/
+local	struct	dwork	**dwtail = &dwhead; /* Where to link the next	*/
+
+local	process	dwdaemon(void);
+
+XINU_TASK(dwd, dwdaemon, DWDSTACK, DWDPRIO);
+
+/*------------------------------------------------------------------------
+ *  dwpost_isr  -  Queue a work item from an interrupt handler (the
+ *		     handler ends with isr_exit)
+ *------------------------------------------------------------------------
+ */
+syscall	dwpost_isr(			/* Assumes interrupts disabled	*/
+	  struct dwork	*dw		/* Item to run			*/
+	)
+{
+	if (dw->dwpending) {		/* Already queued: run it once	*/
+		dw->dwmerged++;
+		return OK;
+	}
+	dw->dwpending = TRUE;
+	dw->dwposted = getmicros();
+	dw->dwnext = NULL;
+	*dwtail = dw;
+	dwtail = &dw->dwnext;
+	return notify_isr(XINU_TASKPID(dwd), DWNOTE);
+}
+
+/*------------------------------------------------------------------------
+ *  dwpost  -  Queue a work item from a process
+ *------------------------------------------------------------------------
+ */
+syscall	dwpost(
+	  struct dwork	*dw		/* Item to run			*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	syscall	retval;
+
+	mask = disable();
+	retval = dwpost_isr(dw);
+	isr_exit();
+	restore(mask);
+	return retval;
+}
+
+/*------------------------------------------------------------------------
+ *  dwreport  -  Print the run count and latency of a work item
+ *------------------------------------------------------------------------
+ */
+void	dwreport(
+	  struct dwork	*dw,		/* Item to report		*/
+	  char		*name		/* Label for the output		*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	uint16	runs, merged;
+	uint32	maxlat, totlat;
+
+	mask = disable();
+	runs = dw->dwruns;
+	merged = dw->dwmerged;
+	maxlat = dw->dwmaxlat;
+	totlat = dw->dwtotlat;
+	restore(mask);
+
+	kprintf("%s: runs %d merged %d lat avg %ld max %ld us\n", name,
+		runs, merged, runs ? totlat / runs : 0, maxlat);
+}
+
+/*------------------------------------------------------------------------
+ *  dwdaemon  -  Run pending work items in the order they were posted
+ *------------------------------------------------------------------------
+ */
+local	process	dwdaemon(void)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	struct	dwork	*dw;		/* Item being run		*/
+	uint32	lat;			/* Its post-to-start time	*/
+
+	while (TRUE) {
+		notifywait(DWNOTE, NOTIFYFOREVER);
+		mask = disable();
+		while ((dw = dwhead) != NULL) {
+			if ((dwhead = dw->dwnext) == NULL) {
+				dwtail = &dwhead;
+			}
+			dw->dwpending = FALSE;
+			lat = getmicros() - dw->dwposted;
+			dw->dwruns++;
+			dw->dwtotlat += lat;
+			if (lat > dw->dwmaxlat) {
+				dw->dwmaxlat = lat;
+			}
+			restore(mask);
+			dw->dwfunc(dw->dwarg);
+			mask = disable();
+		}
+		restore(mask);
+	}
+	return OK;
+}
+
+#endif
@@ -21,7 +21,7 @@ syscall	init(
 		return SYSERR;
 	}
 	devptr = (struct dentry *) &devtab[descrp];
-	retval = (*devptr->dvinit) (devptr);
+	retval = (*devptr->dvinit) ((struct dentry *) devptr);
 	restore(mask);
 	return retval;
 }
@@ -69,7 +69,20 @@ void	nulluser()
 	int pid = create(NULL, INITSTK, 10, "nullp", 0, NULL);
 	struct procent * prptr = &proctab[pid];
 	prptr->prstate = PR_CURR;
+
+#if NMPOOL > 0
+	/* Carve the fixed-block pools now that the null process owns	*/
+	/*   the top of the heap, which overlaps the boot stack		*/
+
+	if (mpinit() == SYSERR) {
+		panic("mpinit");
+	}
+#endif
 	
+	/* Create the tasks declared with XINU_TASK */
+
+	xtaskinit();
+
 	/* Enable interrupts */
 
 	enable();
@@ -77,10 +90,39 @@ void	nulluser()
 	/* main */
 
 	// resume(create((void *)main, 440, INITPRIO, "main", 0, NULL));
-	resume(create((void *)main, 256, INITPRIO, "main", 0, NULL));
+	pid = create((void *)main, 256, INITPRIO, "main", 0, NULL);
+	if (pid == SYSERR) {		/* NPROC too small for the tasks */
+		panic("main");
+	}
+	resume(pid);
+
+#if SWTIMER
+	resume(XINU_TASKPID(tmd));	/* Timer daemon (see swtimer.c)	*/
+#endif
+#if DWORK
+	resume(XINU_TASKPID(dwd));	/* Work daemon (see dwork.c)	*/
+#endif
+#if KLOG
+	resume(XINU_TASKPID(klogd));	/* Log daemon (see klog.c)	*/
+#endif
 
 	/* nullprocess continues here */
+#if TICKLESS || TRACE
+	for(;;) {
+#if TRACE
+		tracedrain();		/* Send queued trace events	*/
+#endif
+#if TICKLESS
+		disable();
+		if (rdyempty() && !tracepending()) {
+			clkidle();	/* Nothing else to run: idle	*/
+		}
+		enable();
+#endif
+	}
+#else
 	for(;;);
+#endif
 
 }
 
@@ -123,7 +165,11 @@ static	void	sysinit()
 	for (i = 0; i < NPROC; i++) {
 		prptr = &proctab[i];
 		prptr->prstate = PR_FREE;
+#if KCOMPACT
+		prptr->prname = "";
+#else
 		prptr->prname[0] = NULLCH;
+#endif
 		prptr->prstkbase = NULL;
 		prptr->prprio = 0;
 	}
@@ -138,6 +184,11 @@ static	void	sysinit()
 		semptr->squeue = newqueue();
 	}
 
+#if NMUTEX > 0
+	/* Initialize mutexes */
+
+	mutinit();
+#endif
 
 	/* Initialize buffer pools */
 
@@ -145,7 +196,11 @@ static	void	sysinit()
 
 	/* Create a ready list for processes */
 
+#if RDYBITMAP
+	rdyinit();
+#else
 	readylist = newqueue();
+#endif
 	
 	for (i = 0; i < NDEVS; i++) {
 		init(i);
@@ -1,4 +1,4 @@
-/* insertd.c - insertd */
+/* insertd.c - insertd, insertdelta */
 
 #include <xinu.h>
 
@@ -9,16 +9,41 @@
 status	insertd(			/* Assumes interrupts disabled	*/
 	  pid32		pid,		/* ID of process to insert	*/
 	  qid16		q,		/* ID of queue to use		*/
-	  uint16 	key		/* Delay from "now" (in ms.)	*/
+	  uint32 	key		/* Delay from "now" (in ms.)	*/
 	)
 {
-	int32	next;			/* Runs through the delta list	*/
-	int32	prev;			/* Follows next through the list*/
-
 	if (isbadqid(q) || isbadpid(pid)) {
 		return SYSERR;
 	}
 
+	/* Keys are 16 bits: a long delay is queued as its low part	*/
+	/*   and wakeup() requeues the process once per SLCHUNK ms	*/
+	/*   still recorded in prslhi					*/
+
+	proctab[pid].prslhi = key >> SLSHIFT;
+	key &= SLCHUNK - 1;
+	if (key == 0 && proctab[pid].prslhi > 0) {
+		proctab[pid].prslhi--;
+		key = SLCHUNK;
+	}
+	insertdelta(pid, q, key);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  insertdelta  -  Insert a process in delta list with a 16-bit delay,
+ *			leaving prslhi as it is
+ *------------------------------------------------------------------------
+ */
+void	insertdelta(			/* Assumes interrupts disabled	*/
+	  pid32		pid,		/* ID of process to insert	*/
+	  qid16		q,		/* ID of queue to use		*/
+	  uint16 	key		/* Delay from "now" (in ms.)	*/
+	)
+{
+	int32	next;			/* Runs through the delta list	*/
+	int32	prev;			/* Follows next through the list*/
+
 	prev = queuehead(q);
 	next = queuetab[queuehead(q)].qnext;
 	while ((next != queuetail(q)) && (queuetab[next].qkey <= key)) {
@@ -37,6 +62,4 @@ status	insertd(			/* Assumes interrupts disabled	*/
 	if (next != queuetail(q)) {
 		queuetab[next].qkey -= key;
 	}
-
-	return OK;
 }
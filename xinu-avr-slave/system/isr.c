@@ -0,0 +1,128 @@
+/* isr.c - isr_ready, signal_isr, send_isr, notify_isr, isr_exit */
+
+#include <xinu.h>
+
+/* Interrupt handlers must not call resched(): signal_isr and send_isr	*/
+/*   only move the released process to the ready list and note that a	*/
+/*   reschedule is due, and the handler calls isr_exit() as its last	*/
+/*   statement to perform at most one reschedule.			*/
+
+bool8	isrresched;			/* A reschedule is due at exit	*/
+
+/*------------------------------------------------------------------------
+ *  isr_ready  -  Make a process ready without rescheduling
+ *------------------------------------------------------------------------
+ */
+void	isr_ready(		/* Assumes interrupts disabled	*/
+	  pid32		pid		/* ID of process to make ready	*/
+	)
+{
+	struct	procent	*prptr;		/* Ptr to process's table entry	*/
+
+	prptr = &proctab[pid];
+	prptr->prstate = PR_READY;
+	rdyinsert(pid, prptr->prprio);
+	if (prptr->prprio > proctab[currpid].prprio) {
+		isrresched = TRUE;
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  signal_isr  -  Signal a semaphore from an interrupt handler
+ *------------------------------------------------------------------------
+ */
+syscall	signal_isr(			/* Assumes interrupts disabled	*/
+	  sid32		sem		/* ID of semaphore to signal	*/
+	)
+{
+	struct	sentry *semptr;		/* Ptr to sempahore table entry	*/
+
+	if (isbadsem(sem)) {
+		return SYSERR;
+	}
+	semptr = &semtab[sem];
+	if (semptr->sstate == S_FREE) {
+		return SYSERR;
+	}
+	trace(TR_SIGNAL, sem);
+	if ((semptr->scount++) < 0) {	/* Release a waiting process */
+		isr_ready(semdequeue(sem));
+	}
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  send_isr  -  Pass a message to a process from an interrupt handler
+ *------------------------------------------------------------------------
+ */
+syscall	send_isr(			/* Assumes interrupts disabled	*/
+	  pid32		pid,		/* ID of recipient process	*/
+	  umsg32	msg		/* Contents of message		*/
+	)
+{
+	struct	procent *prptr;		/* Ptr to process's table entry	*/
+
+	if (isbadpid(pid)) {
+		return SYSERR;
+	}
+	prptr = &proctab[pid];
+	if (prptr->prhasmsg) {
+		return SYSERR;
+	}
+	prptr->prmsg = msg;		/* Deliver message		*/
+	prptr->prhasmsg = TRUE;		/* Indicate message is waiting	*/
+
+	/* If recipient waiting or in timed-wait make it ready */
+
+	if (prptr->prstate == PR_RECV) {
+		isr_ready(pid);
+	} else if (prptr->prstate == PR_RECTIM) {
+		unsleep(pid);
+		isr_ready(pid);
+	}
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  notify_isr  -  Set notification bits of a process from an interrupt
+ *		     handler
+ *------------------------------------------------------------------------
+ */
+syscall	notify_isr(			/* Assumes interrupts disabled	*/
+	  pid32		pid,		/* ID of process to notify	*/
+	  uint16	bits		/* Bits to set			*/
+	)
+{
+	struct	procent *prptr;		/* Ptr to process's table entry	*/
+
+	if (isbadpid(pid)) {
+		return SYSERR;
+	}
+	prptr = &proctab[pid];
+	prptr->prnotify |= bits;
+
+	/* If recipient waits for one of the bits make it ready */
+
+	if ((prptr->prnotify & prptr->prnmask) != 0) {
+		if (prptr->prstate == PR_NOTIFY) {
+			isr_ready(pid);
+		} else if (prptr->prstate == PR_NOTIM) {
+			unsleep(pid);
+			isr_ready(pid);
+		}
+	}
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  isr_exit  -  Epilogue for interrupt handlers that used the _isr calls:
+ *		   reschedule once if a higher priority process was released
+ *------------------------------------------------------------------------
+ */
+void	isr_exit(void)			/* Assumes interrupts disabled	*/
+{
+	if (isrresched) {
+		isrresched = FALSE;
+		resched();
+	}
+}
@@ -12,7 +12,9 @@ syscall	kill(
 {
 	intmask	mask;			/* Saved interrupt mask		*/
 	struct	procent *prptr;		/* Ptr to process's table entry	*/
+#if NDESC > 0
 	int32	i;			/* Index into descriptors	*/
+#endif
 
 	mask = disable();
 	if (isbadpid(pid) || (pid == NULLPROC)
@@ -26,9 +28,14 @@ syscall	kill(
 	}
 
 	send(prptr->prparent, pid);
+#if NMUTEX > 0
+	mutkill(pid);
+#endif
+#if NDESC > 0
 	for (i=0; i<3; i++) {
 		close(prptr->prdesc[i]);
 	}
+#endif
 	freestk(prptr->prstkbase, prptr->prstklen);
 
 	switch (prptr->prstate) {
@@ -38,16 +45,34 @@ syscall	kill(
 
 	case PR_SLEEP:
 	case PR_RECTIM:
+	case PR_NOTIM:
 		unsleep(pid);
 		prptr->prstate = PR_FREE;
 		break;
 
+	case PR_WAITIM:
+		semtab[prptr->prsem].scount++;
+		semtab[prptr->prsem].stimed--;
+		unsleep(pid);
+		prptr->prstate = PR_FREE;
+		break;
+
+#if NMUTEX > 0
+	case PR_MUTEX:
+		getitem(pid);		/* Remove from mutex queue */
+		prptr->prstate = PR_FREE;
+		prioupdate(mutab[prptr->prmutex].muowner);
+		break;
+#endif
+
 	case PR_WAIT:
 		semtab[prptr->prsem].scount++;
-		/* Fall through */
+		getitem(pid);		/* Remove from semaphore queue */
+		prptr->prstate = PR_FREE;
+		break;
 
 	case PR_READY:
-		getitem(pid);		/* Remove from queue */
+		rdyremove(pid);		/* Remove from ready list */
 		/* Fall through */
 
 	default:
@@ -0,0 +1,160 @@
+/* klog.c - klogf, klogdaemon */
+
+#include <xinu.h>
+#include <stdarg.h>
+
+#if KLOG
+
+#if KLOGLEN > 128 || (KLOGLEN & (KLOGLEN - 1)) != 0
+#error "KLOGLEN must be a power of 2 no larger than 128"
+#endif
+
+#ifndef	CONSOLE
+#error "klog sends its records through the CONSOLE device"
+#endif
+
+local	byte	klbuf[KLOGLEN];		/* Ring of records		*/
+local	byte	klhead;			/* Next byte to fill		*/
+local	byte	kltail;			/* Next byte to send		*/
+local	byte	kllost;			/* Records dropped, saturating	*/
+
+#define	klcount()	((byte)(klhead - kltail))
+#define	klput(b)	(klbuf[klhead++ & (KLOGLEN - 1)] = (byte)(b))
+
+local	process	klogdaemon(void);
+
+XINU_TASK(klogd, klogdaemon, KLOGSTACK, KLOGPRIO);
+
+/*------------------------------------------------------------------------
+ *  klogput  -  Store the header of a record in the ring
+ *------------------------------------------------------------------------
+ */
+local	void	klogput(		/* Assumes interrupts disabled	*/
+	  uint16	fmt,		/* Flash address of the format	*/
+	  uint16	tick,		/* Low half of clkticks		*/
+	  byte		len		/* Bytes of arguments to follow	*/
+	)
+{
+	klput(KLSYNC);
+	klput(fmt);
+	klput(fmt >> 8);
+	klput(tick);
+	klput(tick >> 8);
+	klput(len);
+}
+
+/*------------------------------------------------------------------------
+ *  klognext  -  Advance past the next conversion of a format and return
+ *		   the bytes its argument takes, or 0 at the end
+ *------------------------------------------------------------------------
+ */
+local	byte	klognext(
+	  const __flash char **pp	/* Position in the format	*/
+	)
+{
+	const __flash char *p = *pp;	/* Walks the format		*/
+	char	c;			/* Conversion character		*/
+
+	while (*p != NULLCH) {
+		if (*p++ != '%') {
+			continue;
+		}
+		while (*p != NULLCH && strchr("-+ #0123456789.", *p)) {
+			p++;
+		}
+		if ((c = *p) == NULLCH) {
+			break;
+		}
+		p++;
+		if (c == '%') {
+			continue;
+		}
+		*pp = p;
+		return (c == 'l') ? 4 : 2;
+	}
+	*pp = p;
+	return 0;
+}
+
+/*------------------------------------------------------------------------
+ *  klogf  -  Queue a log record; the text is built on the host (see
+ *	      klog() in klog.h, which keeps the format in flash)
+ *------------------------------------------------------------------------
+ */
+void	klogf(
+	  const __flash char *fmt,	/* Format string, in flash	*/
+	  ...
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	va_list	ap;
+	const __flash char *p;		/* Walks the format		*/
+	byte	len;			/* Bytes of arguments		*/
+	byte	n;			/* Bytes of one argument	*/
+	uint16	tick;			/* Time stamp			*/
+	uint32	val;			/* Argument being stored	*/
+
+	/* The sizes of the arguments come from the conversions */
+
+	len = 0;
+	p = fmt;
+	while ((n = klognext(&p)) != 0) {
+		len += n;
+	}
+
+	mask = disable();
+	tick = (uint16)clkticks;
+	if (kllost > 0 && KLOGLEN - klcount() >= KLHDR + 1) {
+		klogput(0, tick, 1);
+		klput(kllost);
+		kllost = 0;
+	}
+	if (KLOGLEN - klcount() < KLHDR + len) {
+		if (kllost < 0xff) {
+			kllost++;
+		}
+		restore(mask);
+		return;
+	}
+	klogput((uint16)fmt, tick, len);
+	va_start(ap, fmt);
+	p = fmt;
+	while ((n = klognext(&p)) != 0) {
+		if (n == 4) {
+			val = va_arg(ap, uint32);
+			klput(val);
+			klput(val >> 8);
+			klput(val >> 16);
+			klput(val >> 24);
+		} else {
+			val = (uint16)va_arg(ap, int);
+			klput(val);
+			klput(val >> 8);
+		}
+	}
+	va_end(ap);
+	notify_isr(XINU_TASKPID(klogd), KLNOTE);
+	restore(mask);
+}
+
+/*------------------------------------------------------------------------
+ *  klogdaemon  -  Send queued log bytes through CONSOLE; putc blocks
+ *		   while the tty output queue is full
+ *------------------------------------------------------------------------
+ */
+local	process	klogdaemon(void)
+{
+	byte	c;			/* Byte to send			*/
+
+	while (TRUE) {
+		notifywait(KLNOTE, NOTIFYFOREVER);
+		while (klcount() > 0) {	/* Only this process moves tail	*/
+			c = klbuf[kltail & (KLOGLEN - 1)];
+			kltail++;
+			putc(CONSOLE, c);
+		}
+	}
+	return OK;
+}
+
+#endif
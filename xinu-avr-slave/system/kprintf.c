@@ -39,6 +39,7 @@ syscall kgetc(void)
 }
 
 extern	void	_doprnt(char *, va_list, int (*)(int));
+extern	int	vsnprintf(char *, size_t, const char *, va_list);
 
 
 
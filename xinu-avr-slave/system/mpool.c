@@ -0,0 +1,188 @@
+/* mpool.c - mpinit, mpget, mpfree, mpreport */
+
+#include <xinu.h>
+
+#if NMPOOL > 0
+
+local	const __flash uint16	mpsizes[NMPOOL] = { MPSIZES };
+local	const __flash uint16	mpcounts[NMPOOL] = { MPCOUNTS };
+
+typedef	char	mpcheck[sizeof((uint16 []){ MPSIZES }) == sizeof(mpsizes)
+		     && sizeof((uint16 []){ MPCOUNTS }) == sizeof(mpcounts)
+		     ? 1 : -1];		/* NMPOOL matches both lists	*/
+
+struct	mpclass	mptab[NMPOOL];		/* Size classes, smallest first	*/
+
+/*------------------------------------------------------------------------
+ *  mpinit  -  Carve one arena per size class from the heap and thread
+ *		 its blocks into a free list
+ *------------------------------------------------------------------------
+ */
+status	mpinit(void)
+{
+	struct	mpclass	*mpptr;		/* Ptr to class being built	*/
+	char	*blk;			/* Walks through the arena	*/
+	uint16	size;			/* Block size of the class	*/
+	int16	i;
+	uint16	j;
+
+	for (i = 0; i < NMPOOL; i++) {
+		mpptr = &mptab[i];
+		size = (uint16)roundmb(mpsizes[i]);
+		if (i > 0 && size <= mptab[i-1].mpsize) {
+			return SYSERR;	/* Classes must grow		*/
+		}
+
+		/* Set the size only once the arena exists, so getmem	*/
+		/*   does not look for it in this class			*/
+
+		blk = getmem((uint32)size * mpcounts[i]);
+		if (blk == (char *)SYSERR) {
+			return SYSERR;
+		}
+		mpptr->mpbase = blk;
+		mpptr->mpsize = size;
+		mpptr->mpcount = mpcounts[i];
+		mpptr->mpflist = NULL;
+		blk = mpptr->mpbase + (mpptr->mpcount - 1) * mpptr->mpsize;
+		for (j = 0; j < mpptr->mpcount; j++) {
+			*(char **)blk = mpptr->mpflist;
+			mpptr->mpflist = blk;
+			blk -= mpptr->mpsize;
+		}
+		mpptr->mpnfree = mpptr->mpminfree = mpptr->mpcount;
+	}
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  mpget  -  Take a block from the smallest class that fits and has one
+ *		free, returning SYSERR if there is none
+ *------------------------------------------------------------------------
+ */
+char	*mpget(
+	  uint32	nbytes		/* Size of memory requested	*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	struct	mpclass	*mpptr;		/* Ptr to class being tried	*/
+	struct	mpclass	*fit;		/* Smallest class that fits	*/
+	char	*blk;			/* Block to return		*/
+	int16	i;
+
+	mask = disable();
+	fit = NULL;
+	for (i = 0; i < NMPOOL; i++) {
+		mpptr = &mptab[i];
+		if (mpptr->mpsize < nbytes) {
+			continue;
+		}
+		if (fit == NULL) {
+			fit = mpptr;
+		}
+		if (mpptr->mpnfree > 0) {
+			break;
+		}
+	}
+	if (fit == NULL || nbytes == 0) {	/* Larger than any class*/
+		restore(mask);
+		return (char *)SYSERR;
+	}
+	if (i == NMPOOL) {			/* Every fitting class	*/
+		fit->mpfails++;			/*   is exhausted	*/
+		restore(mask);
+		return (char *)SYSERR;
+	}
+	if (mpptr != fit) {
+		fit->mpspill++;
+	}
+
+	blk = mpptr->mpflist;
+	mpptr->mpflist = *(char **)blk;
+	if (--mpptr->mpnfree < mpptr->mpminfree) {
+		mpptr->mpminfree = mpptr->mpnfree;
+	}
+	mpptr->mpasked += nbytes;
+	mpptr->mpgiven += mpptr->mpsize;
+	restore(mask);
+	return blk;
+}
+
+/*------------------------------------------------------------------------
+ *  mpfree  -  Return a block to its class; SYSERR if the address is in
+ *		 an arena but not the start of a block, MPNOTPOOL if it is
+ *		 in no arena
+ *------------------------------------------------------------------------
+ */
+syscall	mpfree(
+	  char		*blk		/* Block returned by mpget	*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	struct	mpclass	*mpptr;		/* Ptr to class being tried	*/
+	uint16	off;			/* Offset of blk in the arena	*/
+	int16	i;
+
+	mask = disable();
+	for (i = 0; i < NMPOOL; i++) {
+		mpptr = &mptab[i];
+		if (mpptr->mpbase == NULL || blk < mpptr->mpbase) {
+			continue;
+		}
+		off = blk - mpptr->mpbase;
+		if (off >= mpptr->mpsize * mpptr->mpcount) {
+			continue;
+		}
+		if (off % mpptr->mpsize != 0) {
+			restore(mask);		/* Inside a block	*/
+			return SYSERR;
+		}
+		*(char **)blk = mpptr->mpflist;
+		mpptr->mpflist = blk;
+		mpptr->mpnfree++;
+		restore(mask);
+		return OK;
+	}
+	restore(mask);
+	return MPNOTPOOL;
+}
+
+/*------------------------------------------------------------------------
+ *  mpreport  -  Print pool usage and heap fragmentation statistics
+ *------------------------------------------------------------------------
+ */
+void	mpreport(void)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	struct	mpclass	*mpptr;		/* Ptr to class being printed	*/
+	struct	memblk	*memptr;	/* Walks the heap free list	*/
+	uint32	largest;		/* Largest free heap block	*/
+	int16	i;
+
+	/* Per class: size, peak blocks in use of total, spills,	*/
+	/*   failures, and bytes asked for / handed out (the ratio	*/
+	/*   is the internal fragmentation)				*/
+
+	for (i = 0; i < NMPOOL; i++) {
+		mpptr = &mptab[i];
+		kprintf("mp %d: %d/%d s%d f%d %ld/%ld\n", mpptr->mpsize,
+			mpptr->mpcount - mpptr->mpminfree, mpptr->mpcount,
+			mpptr->mpspill, mpptr->mpfails,
+			mpptr->mpasked, mpptr->mpgiven);
+	}
+
+	/* Heap: free bytes and the largest block (external		*/
+	/*   fragmentation is 1 - largest / free)			*/
+
+	mask = disable();
+	largest = 0;
+	for (memptr = memlist.mnext; memptr != NULL; memptr = memptr->mnext) {
+		if (memptr->mlength > largest) {
+			largest = memptr->mlength;
+		}
+	}
+	restore(mask);
+	kprintf("heap: %ld free, %ld largest\n", memlist.mlength, largest);
+}
+
+#endif
@@ -0,0 +1,83 @@
+/* notify.c - notify, notifywait */
+
+#include <xinu.h>
+
+/*------------------------------------------------------------------------
+ *  notify  -  Set notification bits of a process and start it if it is
+ *		 waiting for any of them
+ *------------------------------------------------------------------------
+ */
+syscall	notify(
+	  pid32		pid,		/* ID of process to notify	*/
+	  uint16	bits		/* Bits to set			*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	struct	procent *prptr;		/* Ptr to process's table entry	*/
+
+	mask = disable();
+	if (isbadpid(pid)) {
+		restore(mask);
+		return SYSERR;
+	}
+
+	prptr = &proctab[pid];
+	prptr->prnotify |= bits;
+
+	/* If recipient waits for one of the bits make it ready */
+
+	if ((prptr->prnotify & prptr->prnmask) != 0) {
+		if (prptr->prstate == PR_NOTIFY) {
+			ready(pid);
+		} else if (prptr->prstate == PR_NOTIM) {
+			unsleep(pid);
+			ready(pid);
+		}
+	}
+	restore(mask);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  notifywait  -  Wait until one of the bits in mask is set, clear those
+ *		     bits and return them, or return TIMEOUT after timeout
+ *		     ms (NOTIFYFOREVER waits indefinitely, 0 just polls)
+ *------------------------------------------------------------------------
+ */
+int32	notifywait(
+	  uint16	bits,		/* Bits to wait for		*/
+	  int32		timeout		/* Max wait in ms		*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	struct	procent	*prptr;		/* Tbl entry of current process	*/
+	uint16	got;			/* Bits to return		*/
+
+	if (bits == 0 || (timeout < 0 && timeout != NOTIFYFOREVER)) {
+		return SYSERR;
+	}
+	mask = disable();
+
+	prptr = &proctab[currpid];
+	if ((prptr->prnotify & bits) == 0 && timeout != 0) {
+		if (timeout == NOTIFYFOREVER) {
+			prptr->prstate = PR_NOTIFY;
+		} else {
+			if (insertd(currpid, sleepq, timeout) == SYSERR) {
+				restore(mask);
+				return SYSERR;
+			}
+			prptr->prstate = PR_NOTIM;
+		}
+		prptr->prnmask = bits;
+		resched();
+		prptr->prnmask = 0;
+	}
+
+	/* Either a bit was set or the timer expired */
+
+	got = prptr->prnotify & bits;
+	prptr->prnotify &= ~got;
+	restore(mask);
+	return (got != 0) ? got : TIMEOUT;
+}
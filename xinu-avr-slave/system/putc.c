@@ -21,7 +21,7 @@ syscall	putc(
 		return SYSERR;
 	}
 	devptr = (struct dentry *) &devtab[descrp];
-	retval = (*devptr->dvputc) (devptr, ch);
+	retval = (*devptr->dvputc) ((struct dentry *) devptr, ch);
 	restore(mask);
 	return retval;
 }
@@ -0,0 +1,134 @@
+/* rdybitmap.c - rdyinit, rdyinsert, rdyremove, rdydequeue, rdyfirstkey */
+
+#include <xinu.h>
+
+#if RDYBITMAP
+
+byte	rdygrp;			/* Bit g set iff rdytbl[g] is nonzero	*/
+byte	rdytbl[NRDYPRIO/8];	/* One bit per nonempty priority level	*/
+byte	rdyhead[NRDYPRIO];	/* First process of each level's FIFO	*/
+
+/* Index of the most significant bit set in a nibble */
+
+local	const __flash byte	msbtab[16] = {
+	0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3
+};
+
+#define	msb8(x)	(((x) & 0xf0) ? 4 + msbtab[(x) >> 4] : msbtab[(x)])
+
+/*------------------------------------------------------------------------
+ *  rdyinit  -  Initialize the ready bitmap and per-level FIFOs
+ *------------------------------------------------------------------------
+ */
+void	rdyinit(void)
+{
+	int32	i;
+
+	rdygrp = 0;
+	for (i = 0; i < NRDYPRIO/8; i++) {
+		rdytbl[i] = 0;
+	}
+	for (i = 0; i < NRDYPRIO; i++) {
+		rdyhead[i] = RDYNONE;
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  rdyinsert  -  Append a process to the FIFO of its priority level
+ *------------------------------------------------------------------------
+ */
+status	rdyinsert(			/* Assumes interrupts disabled	*/
+	  pid32		pid,		/* ID of process to insert	*/
+	  pri16		prio		/* Priority level to use	*/
+	)
+{
+	byte	head;			/* First process at this level	*/
+	qid16	tail;			/* Last process at this level	*/
+
+	if (isbadpid(pid) || isbadprio(prio)) {
+		return SYSERR;
+	}
+
+	/* Each level is a circular list threaded through queuetab;	*/
+	/*   qkey remembers the level in case chprio runs meanwhile	*/
+
+	queuetab[pid].qkey = prio;
+	head = rdyhead[prio];
+	if (head == RDYNONE) {
+		rdyhead[prio] = pid;
+		queuetab[pid].qnext = pid;
+		queuetab[pid].qprev = pid;
+		rdytbl[prio >> 3] |= (1 << (prio & 7));
+		rdygrp |= (1 << (prio >> 3));
+		return OK;
+	}
+	tail = queuetab[head].qprev;
+	queuetab[pid].qnext = head;
+	queuetab[pid].qprev = tail;
+	queuetab[tail].qnext = pid;
+	queuetab[head].qprev = pid;
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  rdyremove  -  Remove a process from an arbitrary point in its FIFO
+ *------------------------------------------------------------------------
+ */
+pid32	rdyremove(			/* Assumes interrupts disabled	*/
+	  pid32		pid		/* ID of process to remove	*/
+	)
+{
+	byte	prio;			/* Level the process is on	*/
+	qid16	prev, next;
+
+	prio = queuetab[pid].qkey;
+	next = queuetab[pid].qnext;
+	if (next == pid) {		/* Last process at this level	*/
+		rdyhead[prio] = RDYNONE;
+		if ((rdytbl[prio >> 3] &= ~(1 << (prio & 7))) == 0) {
+			rdygrp &= ~(1 << (prio >> 3));
+		}
+	} else {
+		prev = queuetab[pid].qprev;
+		queuetab[prev].qnext = next;
+		queuetab[next].qprev = prev;
+		if (rdyhead[prio] == pid) {
+			rdyhead[prio] = next;
+		}
+	}
+	queuetab[pid].qnext = EMPTY;
+	queuetab[pid].qprev = EMPTY;
+	return pid;
+}
+
+/*------------------------------------------------------------------------
+ *  rdyfirstkey  -  Return the highest ready priority, or -1 if none
+ *------------------------------------------------------------------------
+ */
+int16	rdyfirstkey(void)		/* Assumes interrupts disabled	*/
+{
+	byte	grp;			/* Highest nonempty group	*/
+
+	if (rdygrp == 0) {
+		return -1;
+	}
+	grp = msb8(rdygrp);
+	return (grp << 3) + msb8(rdytbl[grp]);
+}
+
+/*------------------------------------------------------------------------
+ *  rdydequeue  -  Remove and return the first process of the highest
+ *		     nonempty priority level
+ *------------------------------------------------------------------------
+ */
+pid32	rdydequeue(void)		/* Assumes interrupts disabled	*/
+{
+	int16	prio;			/* Highest ready priority	*/
+
+	if ((prio = rdyfirstkey()) < 0) {
+		return EMPTY;
+	}
+	return rdyremove(rdyhead[prio]);
+}
+
+#endif
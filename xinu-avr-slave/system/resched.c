@@ -12,6 +12,9 @@ void	resched(void)		/* Assumes interrupts are disabled	*/
 {
 	struct procent *ptold;	/* Ptr to table entry for old process	*/
 	struct procent *ptnew;	/* Ptr to table entry for new process	*/
+#if CPUACCT
+	uint32	now;		/* Time of this switch in us		*/
+#endif
 
 	/* If rescheduling is deferred, record attempt and return */
 
@@ -24,23 +27,51 @@ void	resched(void)		/* Assumes interrupts are disabled	*/
 
 	ptold = &proctab[currpid];
 
+#if STKCHECK
+	/* Check the old process has not run past its stack limit */
+
+	if (ptold->prstate != PR_FREE && !stkcheck(ptold)) {
+		stkoverflow(currpid);
+	}
+#endif
+
 	if (ptold->prstate == PR_CURR) {  /* Process remains eligible */
-		if (ptold->prprio > firstkey(readylist)) {
+		if (ptold->prprio > rdyfirstkey()) {
 			return;
 		}
 
 		/* Old process will no longer remain current */
 
 		ptold->prstate = PR_READY;
-		insert(currpid, readylist, ptold->prprio);
+		rdyinsert(currpid, ptold->prprio);
 	}
 
+#if TICKLESS
+	/* Leaving the null process: go back to the 1 ms tick */
+
+	if (clkperiod != 1) {
+		clkresume();
+	}
+#endif
+
 	/* Force context switch to highest priority ready process */
 
-	currpid = dequeue(readylist);
+	currpid = rdydequeue();
 	ptnew = &proctab[currpid];
+
+#if CPUACCT
+	/* Charge the time since the last switch to the old process */
+
+	now = getmicros();
+	ptold->prcpu += now - cpustamp;
+	cpustamp = now;
+	if (ptnew != ptold) {
+		ptnew->prnswitch++;
+	}
+#endif
 	ptnew->prstate = PR_CURR;
 	preempt = QUANTUM;		/* Reset time slice for process	*/
+	trace(TR_CTXSW, ((ptold - proctab) << 4) | currpid);
 	ctxsw(&ptold->pregs[0],&ptnew->pregs[0]);
 
 	/* Old process returns here when resumed */
@@ -21,7 +21,7 @@ syscall	seek(
 		return SYSERR;
 	}
 	devptr = (struct dentry *) &devtab[descrp];
-	retval = (*devptr->dvseek) (devptr, pos);
+	retval = (*devptr->dvseek) ((struct dentry *) devptr, pos);
 	restore(mask);
 	return retval;
 }
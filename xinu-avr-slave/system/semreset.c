@@ -13,7 +13,6 @@ syscall	semreset(
 {
 	intmask	mask;			/* Saved interrupt mask		*/
 	struct	sentry *semptr;		/* Ptr to semaphore table entry */
-	qid16	semqueue;		/* Semaphore's process queue ID	*/
 	pid32	pid;			/* ID of a waiting process	*/
 
 	mask = disable();
@@ -24,9 +23,8 @@ syscall	semreset(
 	}
 	
 	semptr = &semtab[sem];
-	semqueue = semptr->squeue;	/* Free any waiting processes */
-	resched_cntl(DEFER_START);
-	while ((pid=getfirst(semqueue)) != EMPTY)
+	resched_cntl(DEFER_START);	/* Free any waiting processes */
+	while ((pid=semdequeue(sem)) != EMPTY)
 		ready(pid);
 	semptr->scount = count;		/* Reset count as specified */
 	resched_cntl(DEFER_STOP);
@@ -1,4 +1,4 @@
-/* sleep.c - sleep sleepms */
+/* sleep.c - sleep sleepms sleepuntil */
 
 #include <xinu.h>
 
@@ -47,6 +47,37 @@ syscall	sleepms(
 		restore(mask);
 		return SYSERR;
 	}
+	trace(TR_SLEEP, currpid);
+
+	proctab[currpid].prstate = PR_SLEEP;
+	resched();
+	restore(mask);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  sleepuntil  -  Delay the calling process until the millisecond tick
+ *		     counter reaches an absolute time
+ *------------------------------------------------------------------------
+ */
+syscall	sleepuntil(
+	  uint32	tick		/* Wakeup time (ms since boot)	*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	int32	delay;			/* Time left until tick		*/
+
+	mask = disable();
+	delay = (int32)(tick - clkticks);
+	if (delay <= 0) {		/* Release time already passed	*/
+		restore(mask);
+		return OK;
+	}
+	if (insertd(currpid, sleepq, delay) == SYSERR) {
+		restore(mask);
+		return SYSERR;
+	}
+	trace(TR_SLEEP, currpid);
 
 	proctab[currpid].prstate = PR_SLEEP;
 	resched();
@@ -0,0 +1,110 @@
+/* stkusage.c - stkcheck, stkoverflow, stkusage, stkreport, stkmon */
+
+#include <xinu.h>
+
+void	(*stkhook)(pid32) = NULL;	/* Overflow handler (NULL=panic)*/
+
+#define	STKREPORTMS	10000		/* stkmon reporting period (ms)	*/
+
+/*------------------------------------------------------------------------
+ *  stkcheck  -  Return TRUE if the guard bytes at the stack limit of a
+ *		   process are still intact
+ *------------------------------------------------------------------------
+ */
+bool8	stkcheck(
+	  struct procent *prptr		/* Process to check		*/
+	)
+{
+	byte	*guard;			/* Walks the guard bytes	*/
+	int16	i;
+
+	if (prptr->prstkbase == NULL) {
+		return TRUE;
+	}
+	guard = stkbottom(prptr);
+	for (i = 0; i < STKGUARD; i++) {
+		if (*guard++ != STKPAINT) {
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/*------------------------------------------------------------------------
+ *  stkoverflow  -  Report that a process has overflowed its stack
+ *------------------------------------------------------------------------
+ */
+void	stkoverflow(
+	  pid32		pid		/* Process that overflowed	*/
+	)
+{
+	if (stkhook != NULL) {
+		stkhook(pid);
+		return;
+	}
+	kprintf("\nstack overflow: %d\n", (int)pid);
+	panic(proctab[pid].prname);
+}
+
+/*------------------------------------------------------------------------
+ *  stkusage  -  Return the most stack bytes a process has ever used
+ *------------------------------------------------------------------------
+ */
+int32	stkusage(
+	  pid32		pid		/* Process ID			*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	struct	procent	*prptr;		/* Ptr to process's table entry	*/
+	byte	*p;			/* Scans up from the stack limit*/
+	int32	used;			/* Bytes used to return		*/
+
+	mask = disable();
+	if (isbadpid(pid) || (prptr = &proctab[pid])->prstkbase == NULL) {
+		restore(mask);
+		return SYSERR;
+	}
+
+	/* Bytes still holding the paint were never touched */
+
+	p = stkbottom(prptr);
+	while (p <= (byte *)prptr->prstkbase && *p == STKPAINT) {
+		p++;
+	}
+	used = (byte *)prptr->prstkbase - p + 1;
+	restore(mask);
+	return used;
+}
+
+/*------------------------------------------------------------------------
+ *  stkreport  -  Print the peak stack usage of every live process
+ *------------------------------------------------------------------------
+ */
+void	stkreport(void)
+{
+	pid32	pid;			/* Runs through the process table*/
+	struct	procent	*prptr;		/* Ptr to process's table entry	*/
+
+	for (pid = 0; pid < NPROC; pid++) {
+		prptr = &proctab[pid];
+		if (prptr->prstate == PR_FREE) {
+			continue;
+		}
+		kprintf("stk %d %s %d/%d\n", (int)pid, prptr->prname,
+			(int)stkusage(pid), (int)prptr->prstklen);
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  stkmon  -  Process that prints the stack report periodically
+ *		 (create it with a low priority while sizing stacks)
+ *------------------------------------------------------------------------
+ */
+process	stkmon(void)
+{
+	while (TRUE) {
+		sleepms(STKREPORTMS);
+		stkreport();
+	}
+	return OK;
+}
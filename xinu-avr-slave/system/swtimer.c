@@ -0,0 +1,142 @@
+/* swtimer.c - tmstart, tmstop, tmnotify, tmdaemon */
+
+#include <xinu.h>
+
+#if SWTIMER
+
+struct	swtimer	*tmlist;		/* Active timers, soonest first	*/
+
+local	process	tmdaemon(void);
+
+XINU_TASK(tmd, tmdaemon, TMDSTACK, TMDPRIO);
+
+/*------------------------------------------------------------------------
+ *  tminsert  -  Link a timer into the active list by expiry time
+ *------------------------------------------------------------------------
+ */
+local	void	tminsert(		/* Assumes interrupts disabled	*/
+	  struct swtimer *tm		/* Timer with tmexpiry set	*/
+	)
+{
+	struct	swtimer	**prev;		/* Link to update		*/
+
+	prev = &tmlist;
+	while (*prev != NULL
+	       && (int32)((*prev)->tmexpiry - tm->tmexpiry) <= 0) {
+		prev = &(*prev)->tmnext;
+	}
+	tm->tmnext = *prev;
+	*prev = tm;
+	tm->tmactive = TRUE;
+}
+
+/*------------------------------------------------------------------------
+ *  tmunlink  -  Remove a timer from the active list if it is there
+ *------------------------------------------------------------------------
+ */
+local	void	tmunlink(		/* Assumes interrupts disabled	*/
+	  struct swtimer *tm		/* Timer to remove		*/
+	)
+{
+	struct	swtimer	**prev;		/* Link to update		*/
+
+	if (!tm->tmactive) {
+		return;
+	}
+	for (prev = &tmlist; *prev != tm; prev = &(*prev)->tmnext) {
+		;
+	}
+	*prev = tm->tmnext;
+	tm->tmactive = FALSE;
+}
+
+/*------------------------------------------------------------------------
+ *  tmstart  -  (Re)start a timer: call func(arg) in delay ms and then
+ *		  every period ms (period 0 for a one-shot timer)
+ *------------------------------------------------------------------------
+ */
+syscall	tmstart(
+	  struct swtimer *tm,		/* Caller-owned timer		*/
+	  uint32	delay,		/* ms until the first call	*/
+	  uint16	period,		/* ms between calls, or 0	*/
+	  void		(*func)(void *),/* Callback			*/
+	  void		*arg		/* Argument for the callback	*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+
+	if (func == NULL || delay == 0 || (int32)delay < 0) {
+		return SYSERR;
+	}
+	mask = disable();
+	tmunlink(tm);
+	tm->tmexpiry = clkticks + delay;
+	tm->tmperiod = period;
+	tm->tmfunc = func;
+	tm->tmarg = arg;
+	tminsert(tm);
+	restore(mask);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  tmstop  -  Stop a timer; its callback is not called again
+ *------------------------------------------------------------------------
+ */
+syscall	tmstop(
+	  struct swtimer *tm		/* Timer to stop		*/
+	)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+
+	mask = disable();
+	tmunlink(tm);
+	restore(mask);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  tmnotify  -  Called by the clock handler when tmdue(): wake the
+ *		   timer daemon
+ *------------------------------------------------------------------------
+ */
+void	tmnotify(void)			/* Assumes interrupts disabled	*/
+{
+	notify_isr(XINU_TASKPID(tmd), TMNOTE);
+}
+
+/*------------------------------------------------------------------------
+ *  tmdaemon  -  Run the callbacks of expired timers, reloading the
+ *		   periodic ones from their previous expiry (no drift)
+ *------------------------------------------------------------------------
+ */
+local	process	tmdaemon(void)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	struct	swtimer	*tm;		/* Expired timer		*/
+	void	(*func)(void *);	/* Its callback and argument,	*/
+	void	*arg;			/*   copied before restarting	*/
+
+	while (TRUE) {
+		notifywait(TMNOTE, NOTIFYFOREVER);
+		mask = disable();
+		while (tmdue()) {
+			tm = tmlist;
+			tmlist = tm->tmnext;
+			tm->tmactive = FALSE;
+			func = tm->tmfunc;
+			arg = tm->tmarg;
+			if (tm->tmperiod != 0) {
+				tm->tmexpiry += tm->tmperiod;
+				tminsert(tm);
+			}
+			restore(mask);
+			func(arg);
+			mask = disable();
+		}
+		restore(mask);
+	}
+	return OK;
+}
+
+#endif
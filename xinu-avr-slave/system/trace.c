@@ -0,0 +1,138 @@
+/* trace.c - tracerec, tracerecclk, tracedrain, tracepending */
+
+#include <xinu.h>
+
+/* avr specific */
+#include <avr/io.h>
+
+#if TRACE
+
+#if !defined(CONSOLE) || Ntty == 0
+#error "the trace is sent through the CONSOLE tty"
+#endif
+
+#if TY_OBUFLEN < TREVBYTES
+#error "the tty output queue must hold a whole trace event"
+#endif
+
+#if TRACELEN > 128 || (TRACELEN & (TRACELEN - 1)) != 0
+#error "TRACELEN must be a power of 2 no larger than 128"
+#endif
+
+struct	trevent	trbuf[TRACELEN];	/* Ring of recorded events	*/
+byte	trhead;				/* Next slot to fill		*/
+byte	trtail;				/* Next event to send		*/
+byte	trlost;				/* Events dropped, saturating	*/
+local	uint16	trclklast;		/* clkticks at last traced tick	*/
+local	bool8	trclkon;		/* This tick is being traced	*/
+
+#define	trcount()	((byte)(trhead - trtail))
+
+/*------------------------------------------------------------------------
+ *  tracerec  -  Record one event in the trace ring, or count it as lost
+ *		   if the ring is full (the oldest events are kept)
+ *------------------------------------------------------------------------
+ */
+void	tracerec(			/* Assumes interrupts disabled	*/
+	  byte		type,		/* Event type (TR_...)		*/
+	  byte		arg		/* Event argument		*/
+	)
+{
+	struct	trevent	*ev;		/* Slot being filled		*/
+	byte	tick, tcnt;		/* Timestamp			*/
+
+	tick = (byte)clkticks;
+	tcnt = TCNT2;
+
+	/* A compare match whose interrupt is still pending has	*/
+	/*   restarted TCNT2 without updating clkticks yet		*/
+
+	if (TIFR2 & (1 << OCF2A)) {
+		tick++;
+		tcnt = TCNT2;
+	}
+
+	if (trlost > 0 && trcount() < TRACELEN) {
+		ev = &trbuf[trhead++ & (TRACELEN - 1)];
+		ev->trtype = TR_LOST;
+		ev->trarg = trlost;
+		ev->trtick = tick;
+		ev->trtcnt = tcnt;
+		trlost = 0;
+	}
+	if (trcount() >= TRACELEN) {
+		if (trlost < 0xff) {
+			trlost++;
+		}
+		return;
+	}
+	ev = &trbuf[trhead++ & (TRACELEN - 1)];
+	ev->trtype = type;
+	ev->trarg = arg;
+	ev->trtick = tick;
+	ev->trtcnt = tcnt;
+}
+
+/*------------------------------------------------------------------------
+ *  tracerecclk  -  Record the entry to or exit from the clock handler,
+ *		      once every TRACECLK ms
+ *------------------------------------------------------------------------
+ */
+void	tracerecclk(			/* Assumes interrupts disabled	*/
+	  byte		type		/* TR_ISRIN or TR_ISROUT	*/
+	)
+{
+	if (type == TR_ISRIN) {
+		trclkon = (uint16)((uint16)clkticks - trclklast) >= TRACECLK;
+		if (trclkon) {
+			trclklast = (uint16)clkticks;
+		}
+	}
+	if (trclkon) {
+		tracerec(type, TR_IRQCLK);
+	}
+}
+
+/*------------------------------------------------------------------------
+ *  tracedrain  -  Called by the null process: queue the next event on
+ *		     CONSOLE if the tty output queue has room for all of
+ *		     it; like the input echo it never waits for a slot,
+ *		     and other output cannot land inside an event
+ *------------------------------------------------------------------------
+ */
+void	tracedrain(void)
+{
+	intmask	mask;			/* Saved interrupt mask		*/
+	struct	ttycblk	*typtr;		/* CONSOLE tty control block	*/
+	struct	trevent	*ev;		/* Event being sent		*/
+	byte	i;
+
+	mask = disable();
+	typtr = &ttytab[devtab[CONSOLE].dvminor];
+	if (trcount() == 0 || semcount(typtr->tyosem) < TREVBYTES) {
+		restore(mask);
+		return;
+	}
+	for (i = 0; i < TREVBYTES; i++) {
+		semtry(typtr->tyosem);
+	}
+	ev = &trbuf[trtail++ & (TRACELEN - 1)];
+	typtr->tyobuff[typtr->tyotail++ & (TY_OBUFLEN - 1)] = TRSYNC;
+	typtr->tyobuff[typtr->tyotail++ & (TY_OBUFLEN - 1)] = ev->trtype;
+	typtr->tyobuff[typtr->tyotail++ & (TY_OBUFLEN - 1)] = ev->trarg;
+	typtr->tyobuff[typtr->tyotail++ & (TY_OBUFLEN - 1)] = ev->trtick;
+	typtr->tyobuff[typtr->tyotail++ & (TY_OBUFLEN - 1)] = ev->trtcnt;
+	ttykickout();
+	restore(mask);
+}
+
+/*------------------------------------------------------------------------
+ *  tracepending  -  Return TRUE if trace events are waiting to be sent
+ *------------------------------------------------------------------------
+ */
+bool8	tracepending(void)
+{
+	return trcount() != 0;
+}
+
+#endif
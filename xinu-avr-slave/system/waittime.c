@@ -0,0 +1,113 @@
+/* waittime.c - waittime, semdequeue */
+
+#include <xinu.h>
+
+/* A process has one set of queue links, so a timed waiter cannot be on	*/
+/*   the semaphore queue and on sleepq at once.  It stays on sleepq in	*/
+/*   state PR_WAITIM with the semaphore count already decremented; if	*/
+/*   the delay expires first, wakeup() gives the count back.  Every	*/
+/*   waiter takes a ticket from the semaphore's sseq, and semdequeue()	*/
+/*   releases the oldest ticket, so timed and untimed waiters leave in	*/
+/*   the order they arrived.						*/
+
+/*------------------------------------------------------------------------
+ *  waittime  -  Wait on a semaphore for at most maxwait ms; return OK
+ *		   when signaled or TIMEOUT when the time expired
+ *------------------------------------------------------------------------
+ */
+syscall	waittime(
+	  sid32		sem,		/* Semaphore on which to wait	*/
+	  int32		maxwait		/* Max wait in ms		*/
+	)
+{
+	intmask mask;			/* Saved interrupt mask		*/
+	struct	procent *prptr;		/* Ptr to process's table entry	*/
+	struct	sentry *semptr;		/* Ptr to sempahore table entry	*/
+
+	mask = disable();
+	if (isbadsem(sem) || maxwait < 0) {
+		restore(mask);
+		return SYSERR;
+	}
+
+	semptr = &semtab[sem];
+	if (semptr->sstate == S_FREE) {
+		restore(mask);
+		return SYSERR;
+	}
+
+	trace(TR_WAIT, sem);
+
+	if (semptr->scount > 0) {		/* Available: no delay	*/
+		semptr->scount--;
+		restore(mask);
+		return OK;
+	}
+	if (maxwait == 0) {			/* Caller only polls	*/
+		restore(mask);
+		return TIMEOUT;
+	}
+	if (insertd(currpid, sleepq, maxwait) == SYSERR) {
+		restore(mask);
+		return SYSERR;
+	}
+	semptr->scount--;
+	semptr->stimed++;
+	prptr = &proctab[currpid];
+	prptr->prstate = PR_WAITIM;
+	prptr->prsem = sem;
+	prptr->prwseq = semptr->sseq++;
+	resched();
+
+	/* wakeup() clears prsem when the delay expired */
+
+	if (prptr->prsem == EMPTY) {
+		restore(mask);
+		return TIMEOUT;
+	}
+	restore(mask);
+	return OK;
+}
+
+/*------------------------------------------------------------------------
+ *  semdequeue  -  Remove and return the process that has waited longest
+ *		     on a semaphore, whether on the semaphore queue or a
+ *		     timed waiter on sleepq (EMPTY if none)
+ *------------------------------------------------------------------------
+ */
+pid32	semdequeue(			/* Assumes interrupts disabled	*/
+	  sid32		sem		/* ID of semaphore		*/
+	)
+{
+	struct	sentry *semptr;		/* Ptr to sempahore table entry	*/
+	struct	procent *prptr;		/* Ptr to process's table entry	*/
+	pid32	pid;
+	pid32	oldest;			/* Timed waiter with oldest ticket */
+
+	semptr = &semtab[sem];
+	if (semptr->stimed == 0) {	/* Only untimed waiters, if any	*/
+		return dequeue(semptr->squeue);
+	}
+
+	/* Find the oldest timed waiter and compare it with the head of	*/
+	/*   the semaphore queue; tickets wrap, so compare differences	*/
+
+	oldest = EMPTY;
+	for (pid = 0; pid < NPROC; pid++) {
+		prptr = &proctab[pid];
+		if (prptr->prstate == PR_WAITIM && prptr->prsem == sem
+		    && (oldest == EMPTY || (int16)(prptr->prwseq
+				- proctab[oldest].prwseq) < 0)) {
+			oldest = pid;
+		}
+	}
+
+	pid = firstid(semptr->squeue);
+	if (nonempty(semptr->squeue) && (int16)(proctab[pid].prwseq
+			- proctab[oldest].prwseq) < 0) {
+		return dequeue(semptr->squeue);
+	}
+	semptr->stimed--;
+	unsleep(oldest);
+	return oldest;
+}
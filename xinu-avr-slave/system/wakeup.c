@@ -3,18 +3,30 @@
 #include <xinu.h>
 
 /*------------------------------------------------------------------------
- *  wakeup  -  Called by clock interrupt handler to awaken processes
+ *  wakeup  -  Called by clock interrupt handler to awaken processes;
+ *	       the handler reschedules once at its isr_exit()
  *------------------------------------------------------------------------
  */
-void	wakeup(void)
+void	wakeup(void)			/* Assumes interrupts disabled	*/
 {
+	pid32	pid;			/* Process whose delay expired	*/
+
 	/* Awaken all processes that have no more time to sleep */
 
-	resched_cntl(DEFER_START);
 	while (nonempty(sleepq) && (firstkey(sleepq) <= 0)) {
-		ready(dequeue(sleepq));
+		pid = dequeue(sleepq);
+		if (proctab[pid].prslhi > 0) {	/* Long delay continues	*/
+			proctab[pid].prslhi--;
+			insertdelta(pid, sleepq, SLCHUNK);
+			continue;
+		}
+		if (proctab[pid].prstate == PR_WAITIM) { /* Timed out	*/
+			semtab[proctab[pid].prsem].scount++;
+			semtab[proctab[pid].prsem].stimed--;
+			proctab[pid].prsem = EMPTY;
+		}
+		trace(TR_WAKEUP, pid);
+		isr_ready(pid);
 	}
-
-	resched_cntl(DEFER_STOP);
 	return;
 }
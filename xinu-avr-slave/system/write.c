@@ -22,7 +22,7 @@ syscall	write(
 		return SYSERR;
 	}
 	devptr = (struct dentry *) &devtab[descrp];
-	retval = (*devptr->dvwrite) (devptr, buffer, count);
+	retval = (*devptr->dvwrite) ((struct dentry *) devptr, buffer, count);
 	restore(mask);
 	return retval;
 }
@@ -0,0 +1,24 @@
+/* xtask.c - xtaskinit */
+
+#include <xinu.h>
+
+struct	xtask	*xtasklist = NULL;	/* First static task		*/
+struct	xtask	**xtasktail = &xtasklist; /* Where to link the next one	*/
+
+/*------------------------------------------------------------------------
+ *  xtaskinit  -  Create every task declared with XINU_TASK, suspended,
+ *		    on its statically allocated stack
+ *------------------------------------------------------------------------
+ */
+void	xtaskinit(void)
+{
+	struct	xtask	*xptr;		/* Walks the static task table	*/
+
+	for (xptr = xtasklist; xptr != NULL; xptr = xptr->xnext) {
+		xptr->xpid = createat(xptr->xfunc, xptr->xstk, xptr->xssize,
+				xptr->xprio, xptr->xname);
+		if (xptr->xpid == SYSERR) {	/* Table larger than NPROC */
+			panic(xptr->xname);
+		}
+	}
+}